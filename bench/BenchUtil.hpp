@@ -0,0 +1,112 @@
+#pragma once
+
+// Shared plumbing for the headless benchmarks: argument parsing, the 1..N thread sweep,
+// timing, a work-sharing parallel loop and latency percentiles.
+
+#include "world/BlockRegistry.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace FarHorizon::Bench {
+
+// Positional argument index as a number, or fallback when it was not given
+inline int getIntArg(int argc, char** argv, int index, int fallback) {
+    return argc > index ? std::atoi(argv[index]) : fallback;
+}
+
+inline double getDoubleArg(int argc, char** argv, int index, double fallback) {
+    return argc > index ? std::atof(argv[index]) : fallback;
+}
+
+// Thread count argument (at least 1); defaults to the hardware threads divided by divisor
+inline unsigned int getThreadArg(int argc, char** argv, int index, unsigned int divisor = 1) {
+    unsigned int fallback = std::thread::hardware_concurrency() / divisor;
+    unsigned int threads = argc > index ? static_cast<unsigned int>(std::atoi(argv[index])) : fallback;
+    return std::max(1u, threads);
+}
+
+// 1, 2, 4, ... below maxThreads, then maxThreads itself
+inline std::vector<unsigned int> getThreadCounts(unsigned int maxThreads) {
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+    return threadCounts;
+}
+
+class Stopwatch {
+public:
+    Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+
+    double getSeconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+    double getMicroseconds() const {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+struct ParallelResult {
+    double seconds = 0.0;
+    uint64_t total = 0;  // Sum of body() results
+};
+
+// Runs body(i) for every i in [0, count) on threadCount threads pulling from a shared counter
+// body returns a per-item tally (faces, uniform chunks, ...) that is summed per thread
+template<typename Body>
+ParallelResult runParallel(unsigned int threadCount, size_t count, const Body& body) {
+    std::atomic<size_t> nextIndex{0};
+    std::atomic<uint64_t> total{0};
+
+    auto worker = [&]() {
+        uint64_t tally = 0;
+        for (size_t i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1)) {
+            tally += body(i);
+        }
+        total.fetch_add(tally);
+    };
+
+    Stopwatch stopwatch;
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < threadCount; t++) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return {stopwatch.getSeconds(), total.load()};
+}
+
+inline double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+// Quiet logging and a registered block set for the lifetime of the benchmark
+class ScopedBlockRegistry {
+public:
+    ScopedBlockRegistry() {
+        spdlog::set_level(spdlog::level::warn);
+        BlockRegistry::init();
+    }
+    ~ScopedBlockRegistry() { BlockRegistry::cleanup(); }
+
+    ScopedBlockRegistry(const ScopedBlockRegistry&) = delete;
+    ScopedBlockRegistry& operator=(const ScopedBlockRegistry&) = delete;
+};
+
+} // namespace FarHorizon::Bench
@@ -0,0 +1,85 @@
+// Headless terrain generation benchmark.
+//
+// Generates the same block of chunk positions with each terrain path and reports
+// chunks/s with 1..N threads, plus how many chunks came out uniform (no voxel pass):
+// - heightmap (uncached): ChunkData::generate without a column cache (2D noise per chunk)
+// - heightmap: HeightmapTerrainGenerator (2D noise once per column)
+// - density: DensityTerrainGenerator (coarse 3D lattice + trilinear interpolation)
+//
+// Usage: bench_generation [maxThreads] [radius]
+
+#include "BenchUtil.hpp"
+#include "world/TerrainGenerator.hpp"
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+using namespace FarHorizon;
+using namespace FarHorizon::Bench;
+
+namespace {
+
+// Generates through the 2D path with no column cache, like before TerrainColumnCache existed
+class UncachedHeightmapGenerator : public TerrainGenerator {
+public:
+    const char* getName() const override { return "heightmap (uncached)"; }
+    std::shared_ptr<const ChunkData> generate(const ChunkPosition& position) override {
+        return ChunkData::generate(position);
+    }
+};
+
+// total counts the chunks that came out uniform
+ParallelResult runGeneration(TerrainGenerator& generator, const std::vector<ChunkPosition>& positions,
+                             unsigned int threadCount) {
+    // Every run starts cold, as a freshly loaded area would
+    generator.clearCache();
+
+    return runParallel(threadCount, positions.size(), [&](size_t i) -> uint64_t {
+        auto chunk = generator.generate(positions[i]);
+        return chunk->getStorage().getBitsPerEntry() == 0 ? 1 : 0;
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned int maxThreads = getThreadArg(argc, argv, 1);
+    int32_t radius = getIntArg(argc, argv, 2, 8);
+
+    ScopedBlockRegistry blockRegistry;
+
+    // Columns from well below to well above the surface band, column-major like a loading sphere
+    std::vector<ChunkPosition> positions;
+    for (int32_t x = -radius; x <= radius; x++) {
+        for (int32_t z = -radius; z <= radius; z++) {
+            for (int32_t y = -4; y <= 8; y++) {
+                positions.push_back({x, y, z});
+            }
+        }
+    }
+
+    UncachedHeightmapGenerator uncached;
+    HeightmapTerrainGenerator heightmap;
+    DensityTerrainGenerator density;
+    std::vector<std::reference_wrapper<TerrainGenerator>> generators = {uncached, heightmap, density};
+
+    std::vector<unsigned int> threadCounts = getThreadCounts(maxThreads);
+
+    std::printf("bench_generation: %zu chunks per run (radius %d)\n", positions.size(), radius);
+    std::printf("%-22s %8s %14s %10s\n", "generator", "threads", "chunks/s", "uniform");
+
+    for (TerrainGenerator& generator : generators) {
+        // Warm-up so the noise node and block registry lookups are initialized
+        runGeneration(generator, positions, 1);
+
+        for (unsigned int threads : threadCounts) {
+            ParallelResult result = runGeneration(generator, positions, threads);
+            std::printf("%-22s %8u %14.1f %9.1f%%\n",
+                        generator.getName(), threads,
+                        static_cast<double>(positions.size()) / result.seconds,
+                        100.0 * static_cast<double>(result.total) / positions.size());
+        }
+    }
+
+    return 0;
+}
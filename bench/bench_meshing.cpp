@@ -0,0 +1,133 @@
+// Headless meshing benchmark.
+//
+// Generates a fixed block of terrain chunks, then meshes every chunk with 1..N threads
+// and reports throughput (chunks/s, faces/s) and per-chunk latency percentiles.
+// Runs from the binary directory so the relative assets/ path resolves.
+//
+// Usage: bench_meshing [maxThreads] [radius] [greedy 0|1]
+
+#include "BenchUtil.hpp"
+#include "world/ChunkManager.hpp"
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+using namespace FarHorizon;
+using namespace FarHorizon::Bench;
+
+namespace {
+
+struct MeshInput {
+    ChunkNeighborhood chunks;
+};
+
+struct RunResult {
+    double seconds = 0.0;
+    uint64_t faces = 0;
+    std::vector<double> latenciesUs;
+};
+
+RunResult runMeshing(const ChunkManager& chunkManager, const std::vector<MeshInput>& inputs, unsigned int threadCount) {
+    RunResult result;
+    result.latenciesUs.resize(inputs.size());
+
+    ParallelResult run = runParallel(threadCount, inputs.size(), [&](size_t i) -> uint64_t {
+        Stopwatch stopwatch;
+        CompactChunkMesh mesh = chunkManager.generateChunkMesh(inputs[i].chunks);
+        result.latenciesUs[i] = stopwatch.getMicroseconds();
+        return mesh.faces.size();
+    });
+
+    result.seconds = run.seconds;
+    result.faces = run.total;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned int maxThreads = getThreadArg(argc, argv, 1);
+    int32_t radius = getIntArg(argc, argv, 2, 6);
+    bool greedy = getIntArg(argc, argv, 3, 1) != 0;
+
+    ScopedBlockRegistry blockRegistry;
+
+    ChunkManager chunkManager;
+    chunkManager.setGreedyMeshing(greedy);
+    chunkManager.initializeBlockModels();
+    chunkManager.preloadBlockStateModels();
+    chunkManager.precacheBlockShapes();
+
+    // No GPU here: hand out texture slots in registration order, like TextureManager does
+    uint32_t textureIndex = 0;
+    for (const auto& textureName : chunkManager.getRequiredTextures()) {
+        chunkManager.registerTexture(textureName, textureIndex++);
+    }
+    chunkManager.cacheTextureIndices();
+
+    // Terrain surface sits between y=0 and y=64 and the slab sphere reaches y=80
+    std::unordered_map<ChunkPosition, ChunkDataPtr, ChunkPositionHash> chunks;
+    for (int32_t x = -radius - 1; x <= radius + 1; x++) {
+        for (int32_t y = -2; y <= 6; y++) {
+            for (int32_t z = -radius - 1; z <= radius + 1; z++) {
+                ChunkPosition pos{x, y, z};
+                chunks[pos] = ChunkData::generate(pos);
+            }
+        }
+    }
+
+    auto lookup = [&](const ChunkPosition& pos) -> ChunkDataPtr {
+        auto it = chunks.find(pos);
+        return it != chunks.end() ? it->second : nullptr;
+    };
+
+    std::vector<MeshInput> inputs;
+    for (int32_t x = -radius; x <= radius; x++) {
+        for (int32_t y = -1; y <= 5; y++) {
+            for (int32_t z = -radius; z <= radius; z++) {
+                ChunkPosition pos{x, y, z};
+                ChunkDataPtr chunk = lookup(pos);
+                if (!chunk || chunk->isEmpty()) {
+                    continue;
+                }
+
+                MeshInput input;
+                for (int dz = -1; dz <= 1; dz++) {
+                    for (int dy = -1; dy <= 1; dy++) {
+                        for (int dx = -1; dx <= 1; dx++) {
+                            input.chunks.chunks[ChunkNeighborhood::getIndex(dx, dy, dz)] =
+                                lookup(pos.getNeighbor(dx, dy, dz));
+                        }
+                    }
+                }
+                inputs.push_back(std::move(input));
+            }
+        }
+    }
+
+    // Warm-up pass on one thread so lazily-built caches are populated before timing
+    runMeshing(chunkManager, inputs, 1);
+
+    std::printf("bench_meshing: %zu non-empty chunks (radius %d, greedy %s)\n",
+                inputs.size(), radius, greedy ? "on" : "off");
+
+    size_t chunkBytes = 0;
+    for (const auto& [pos, chunk] : chunks) {
+        chunkBytes += chunk->getMemoryUsage();
+    }
+    std::printf("chunk data: %zu chunks, %.1f KiB total, %.1f bytes/chunk\n",
+                chunks.size(), chunkBytes / 1024.0, static_cast<double>(chunkBytes) / chunks.size());
+    std::printf("%8s %14s %14s %12s %12s\n", "threads", "chunks/s", "faces/s", "p50 (us)", "p99 (us)");
+
+    for (unsigned int threads : getThreadCounts(maxThreads)) {
+        RunResult result = runMeshing(chunkManager, inputs, threads);
+        std::printf("%8u %14.1f %14.1f %12.1f %12.1f\n",
+                    threads,
+                    static_cast<double>(inputs.size()) / result.seconds,
+                    static_cast<double>(result.faces) / result.seconds,
+                    percentile(result.latenciesUs, 0.50),
+                    percentile(result.latenciesUs, 0.99));
+    }
+
+    return 0;
+}
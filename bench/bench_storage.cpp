@@ -0,0 +1,187 @@
+// Headless chunk storage benchmark.
+//
+// Fills ChunkStorage with a sphere of chunks, then hammers it from the mesh worker
+// count of threads and reports lookups per second for get(), contains() and
+// getWithNeighbors() (27 chunks per call), with and without a concurrent writer.
+// The previous layout (std::unordered_map shards, xor-shift hash) runs as a baseline.
+//
+// Usage: bench_storage [threads] [radius] [secondsPerTest]
+
+#include "BenchUtil.hpp"
+#include "world/ChunkStorage.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace FarHorizon;
+using namespace FarHorizon::Bench;
+
+namespace {
+
+// Storage as it was before the flat tables: 64 unordered_map shards keyed by an xor-shift hash
+class BaselineStorage {
+public:
+    struct OldHash {
+        std::size_t operator()(const ChunkPosition& pos) const {
+            std::size_t h1 = std::hash<int32_t>{}(pos.x);
+            std::size_t h2 = std::hash<int32_t>{}(pos.y);
+            std::size_t h3 = std::hash<int32_t>{}(pos.z);
+            return h1 ^ (h2 << 1) ^ (h3 << 2);
+        }
+    };
+
+    void insert(const ChunkPosition& pos, ChunkDataPtr data) {
+        Shard& shard = shards_[OldHash{}(pos) % 64];
+        std::unique_lock lock(shard.mutex);
+        shard.chunks[pos] = std::move(data);
+    }
+
+    ChunkDataPtr get(const ChunkPosition& pos) const {
+        const Shard& shard = shards_[OldHash{}(pos) % 64];
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.chunks.find(pos);
+        return it != shard.chunks.end() ? it->second : nullptr;
+    }
+
+private:
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<ChunkPosition, ChunkDataPtr, OldHash> chunks;
+    };
+    std::array<Shard, 64> shards_;
+};
+
+// Random probe positions: mostly loaded chunks, with a rim of misses around the sphere
+std::vector<ChunkPosition> makeProbes(int32_t radius, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int32_t> coord(-radius - 1, radius + 1);
+    std::vector<ChunkPosition> probes(1 << 16);
+    for (auto& probe : probes) {
+        probe = {coord(rng), coord(rng), coord(rng)};
+    }
+    return probes;
+}
+
+// Runs body(probe) on every thread for the given time, returns operations per second
+double runTest(unsigned int threadCount, double seconds, int32_t radius,
+               const std::function<uint64_t(const ChunkPosition&)>& body,
+               const std::function<void(const std::atomic<bool>&)>& writer = nullptr) {
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> totalOps{0};
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t]() {
+            std::vector<ChunkPosition> probes = makeProbes(radius, 1234 + t);
+            uint64_t ops = 0;
+            size_t i = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int batch = 0; batch < 256; batch++) {
+                    ops += body(probes[i++ & (probes.size() - 1)]);
+                }
+            }
+            totalOps.fetch_add(ops);
+        });
+    }
+    std::thread writerThread;
+    if (writer) {
+        writerThread = std::thread([&]() { writer(stop); });
+    }
+
+    Stopwatch stopwatch;
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+    return static_cast<double>(totalOps.load()) / stopwatch.getSeconds();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned int threads = getThreadArg(argc, argv, 1, 2);
+    int32_t radius = getIntArg(argc, argv, 2, 16);
+    double seconds = getDoubleArg(argc, argv, 3, 1.0);
+
+    ChunkStorage storage;
+    BaselineStorage baseline;
+    size_t chunkCount = 0;
+    for (int32_t x = -radius; x <= radius; x++) {
+        for (int32_t y = -radius; y <= radius; y++) {
+            for (int32_t z = -radius; z <= radius; z++) {
+                if (x * x + y * y + z * z > radius * radius) {
+                    continue;
+                }
+                ChunkPosition pos{x, y, z};
+                auto chunk = std::make_shared<const ChunkData>(pos);
+                storage.insert(pos, chunk);
+                baseline.insert(pos, chunk);
+                chunkCount++;
+            }
+        }
+    }
+
+    std::printf("bench_storage: %zu chunks (radius %d), %u threads, %.1fs per test\n",
+                chunkCount, radius, threads, seconds);
+    std::printf("%-36s %16s\n", "test", "lookups/s");
+
+    auto report = [](const char* name, double opsPerSecond) {
+        std::printf("%-36s %16.0f\n", name, opsPerSecond);
+    };
+
+    report("baseline get", runTest(threads, seconds, radius, [&](const ChunkPosition& pos) {
+        static_cast<void>(baseline.get(pos));
+        return 1u;
+    }));
+    report("get", runTest(threads, seconds, radius, [&](const ChunkPosition& pos) {
+        static_cast<void>(storage.get(pos));
+        return 1u;
+    }));
+    report("contains", runTest(threads, seconds, radius, [&](const ChunkPosition& pos) {
+        static_cast<void>(storage.contains(pos));
+        return 1u;
+    }));
+    report("getWithNeighbors (x27)", runTest(threads, seconds, radius, [&](const ChunkPosition& pos) {
+        ChunkNeighborhood neighborhood = storage.getWithNeighbors(pos);
+        return static_cast<uint64_t>(neighborhood.chunks.size());
+    }));
+    report("baseline 27 x get", runTest(threads, seconds, radius, [&](const ChunkPosition& pos) {
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    static_cast<void>(baseline.get(pos.getNeighbor(dx, dy, dz)));
+                }
+            }
+        }
+        return 27u;
+    }));
+
+    // Churn chunks on the sphere's rim the way unload/generate does
+    report("get + concurrent insert/remove", runTest(threads, seconds, radius, [&](const ChunkPosition& pos) {
+        static_cast<void>(storage.get(pos));
+        return 1u;
+    }, [&](const std::atomic<bool>& stop) {
+        std::vector<ChunkPosition> rim = makeProbes(radius, 99);
+        size_t i = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            const ChunkPosition& pos = rim[i++ & (rim.size() - 1)];
+            if (ChunkDataPtr old = storage.remove(pos)) {
+                storage.insert(pos, std::move(old));
+            }
+        }
+    }));
+
+    return 0;
+}
@@ -8,6 +8,11 @@
 
 namespace FarHorizon {
 
+// Face/lighting bytes the chunk buffer defragmenter may re-upload per frame
+static constexpr size_t DEFRAG_BYTES_PER_FRAME = 1024 * 1024;
+// Face/lighting bytes of new meshes uploaded per frame (at least one mesh always goes through)
+static constexpr size_t UPLOAD_BYTES_PER_FRAME = 4 * 1024 * 1024;
+
 FarHorizonClient::FarHorizonClient()
     : running(false)
     , framebufferResized(false)
@@ -68,6 +73,10 @@ void FarHorizonClient::init() {
     // Initialize chunk manager
     chunkManager = std::make_unique<ChunkManager>();
     chunkManager->setRenderDistance(settings->renderDistance);
+    chunkManager->setGreedyMeshing(settings->greedyMeshing);
+    int32_t lodDistance = settings->lodDistance;
+    chunkManager->setLodRadii({lodDistance, lodDistance * 2, lodDistance * 4});
+    chunkManager->openWorld("saves/world");
     chunkManager->initializeBlockModels();
     chunkManager->preloadBlockStateModels();
     chunkManager->precacheBlockShapes();
@@ -289,7 +298,7 @@ void FarHorizonClient::tick(float deltaTime) {
         camera->setPosition(glm::vec3(interpolatedEyePos));
 
         // Update chunks around player
-        chunkManager->update(camera->getPosition());
+        chunkManager->update(camera->getPosition(), camera->getForward());
 
         // Collect ready meshes from chunk manager
         if (chunkManager->hasReadyMeshes()) {
@@ -301,18 +310,19 @@ void FarHorizonClient::tick(float deltaTime) {
 
         auto& bufferManager = renderManager->getChunkBufferManager();
 
+        // Recycle buffer ranges freed a few frames ago
+        bufferManager.beginFrame();
+
         // Remove unloaded chunks
         bufferManager.removeUnloadedChunks(*chunkManager);
 
-        // Check for compaction
-        bufferManager.compactIfNeeded(bufferManager.getMeshCache());
+        // Incremental compaction, bounded so it never causes a hitch
+        bufferManager.defragment(DEFRAG_BYTES_PER_FRAME);
 
-        // Add pending meshes incrementally (up to 20 per frame)
+        // Add pending meshes incrementally (bounded by bytes uploaded per frame)
         if (!pendingMeshes.empty()) {
-            bufferManager.addMeshes(pendingMeshes, 20);
-            size_t processCount = std::min(pendingMeshes.size(), size_t(20));
+            size_t processCount = bufferManager.addMeshes(pendingMeshes, UPLOAD_BYTES_PER_FRAME);
             pendingMeshes.erase(pendingMeshes.begin(), pendingMeshes.begin() + processCount);
-            renderManager->markQuadInfoForUpdate();
         }
     }
 }
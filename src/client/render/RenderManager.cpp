@@ -53,7 +53,7 @@ RenderManager::RenderManager()
     , geometryDescriptorSet(VK_NULL_HANDLE)
     , sceneTextureIndex(0)
     , blurTexture1Index(0)
-    , quadInfoNeedsUpdate(true) {
+    , uploadedQuadCount(0) {
 }
 
 RenderManager::~RenderManager() = default;
@@ -429,7 +429,7 @@ void RenderManager::createBuffers() {
     // Quad info buffer
     quadInfoBuffer->init(
         vulkanContext->getAllocator(),
-        16384 * sizeof(QuadInfo),
+        MAX_QUAD_INFOS * sizeof(QuadInfo),
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VMA_MEMORY_USAGE_CPU_TO_GPU,
         VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
@@ -459,8 +459,8 @@ void RenderManager::createBuffers() {
                                VMA_MEMORY_USAGE_CPU_TO_GPU,
                                VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT);
 
-    // Chunk buffer manager
-    bufferManager->init(vulkanContext->getAllocator(), 10000000, 5000);
+    // Chunk buffer manager (draw commands sized for LOD view distances)
+    bufferManager->init(*vulkanContext, 10000000, 32768);
 
     // Create descriptor pool
     VkDescriptorPoolSize geometryPoolSizes[] = {
@@ -483,6 +483,8 @@ void RenderManager::createBuffers() {
     geometryAllocInfo.pSetLayouts = &geometrySetLayout;
 
     vkAllocateDescriptorSets(vulkanContext->getDevice().getLogicalDevice(), &geometryAllocInfo, &geometryDescriptorSet);
+
+    writeGeometryDescriptors();
 }
 
 bool RenderManager::beginFrame() {
@@ -500,7 +502,6 @@ void RenderManager::waitIdle() {
 void RenderManager::clearChunkBuffers() {
     waitIdle();
     bufferManager->clear();
-    quadInfoNeedsUpdate = true;
 }
 
 void RenderManager::onResize(uint32_t width, uint32_t height, TextureManager& textureManager) {
@@ -518,75 +519,92 @@ void RenderManager::onResize(uint32_t width, uint32_t height, TextureManager& te
     textureManager.updateExternalTexture(blurTexture1Index, blurTarget1->getColorImageView());
 }
 
+void RenderManager::writeGeometryDescriptors() {
+    // All geometry buffers are fixed-size for the lifetime of the renderer, so this runs once
+    VkDescriptorBufferInfo quadInfoBufferInfo{};
+    quadInfoBufferInfo.buffer = quadInfoBuffer->getBuffer();
+    quadInfoBufferInfo.offset = 0;
+    quadInfoBufferInfo.range = VK_WHOLE_SIZE;
+
+    VkDescriptorBufferInfo lightingBufferInfo{};
+    lightingBufferInfo.buffer = bufferManager->getLightingBuffer();
+    lightingBufferInfo.offset = 0;
+    lightingBufferInfo.range = VK_WHOLE_SIZE;
+
+    VkDescriptorBufferInfo chunkDataBufferInfo{};
+    chunkDataBufferInfo.buffer = bufferManager->getChunkDataBuffer();
+    chunkDataBufferInfo.offset = 0;
+    chunkDataBufferInfo.range = VK_WHOLE_SIZE;
+
+    VkDescriptorBufferInfo faceDataBufferInfo{};
+    faceDataBufferInfo.buffer = bufferManager->getFaceBuffer();
+    faceDataBufferInfo.offset = 0;
+    faceDataBufferInfo.range = VK_WHOLE_SIZE;
+
+    VkWriteDescriptorSet descriptorWrites[4]{};
+    descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[0].dstSet = geometryDescriptorSet;
+    descriptorWrites[0].dstBinding = 0;
+    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptorWrites[0].descriptorCount = 1;
+    descriptorWrites[0].pBufferInfo = &quadInfoBufferInfo;
+
+    descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[1].dstSet = geometryDescriptorSet;
+    descriptorWrites[1].dstBinding = 1;
+    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptorWrites[1].descriptorCount = 1;
+    descriptorWrites[1].pBufferInfo = &lightingBufferInfo;
+
+    descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[2].dstSet = geometryDescriptorSet;
+    descriptorWrites[2].dstBinding = 2;
+    descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptorWrites[2].descriptorCount = 1;
+    descriptorWrites[2].pBufferInfo = &chunkDataBufferInfo;
+
+    descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[3].dstSet = geometryDescriptorSet;
+    descriptorWrites[3].dstBinding = 3;
+    descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptorWrites[3].descriptorCount = 1;
+    descriptorWrites[3].pBufferInfo = &faceDataBufferInfo;
+
+    vkUpdateDescriptorSets(vulkanContext->getDevice().getLogicalDevice(), 4, descriptorWrites, 0, nullptr);
+}
+
+void RenderManager::uploadNewQuadInfos(const ChunkManager& chunkManager) {
+    size_t quadCount = chunkManager.getQuadInfoCount();
+    if (quadCount <= uploadedQuadCount) {
+        return;
+    }
+
+    if (quadCount > MAX_QUAD_INFOS) {
+        if (uploadedQuadCount < MAX_QUAD_INFOS) {
+            spdlog::error("QuadInfo library has {} quads, buffer holds {}", quadCount, MAX_QUAD_INFOS);
+        }
+        quadCount = MAX_QUAD_INFOS;
+    }
+
+    // Quads are append-only and indices past uploadedQuadCount aren't referenced by any
+    // frame in flight, so new entries can be written straight into the mapped buffer
+    QuadInfo* dest = static_cast<QuadInfo*>(quadInfoBuffer->map()) + uploadedQuadCount;
+    uploadedQuadCount += chunkManager.copyQuadInfos(uploadedQuadCount, quadCount - uploadedQuadCount, dest);
+}
+
 void RenderManager::render(Camera& camera, ChunkManager& chunkManager,
                           GameStateManager& gameStateManager, Settings& settings,
                           TextureManager& textureManager,
                           const std::optional<BlockHitResult>& crosshairTarget,
                           int fps) {
     ZoneScoped;
-    // Update QuadInfo buffer if needed
-    if (quadInfoNeedsUpdate) {
-        const auto& quadInfos = chunkManager.getQuadInfos();
-        if (!quadInfos.empty()) {
-            waitIdle();
-
-            void* quadData = quadInfoBuffer->map();
-            memcpy(quadData, quadInfos.data(), quadInfos.size() * sizeof(QuadInfo));
-            quadInfoBuffer->unmap();
-
-            // Update descriptor sets
-            VkDescriptorBufferInfo quadInfoBufferInfo{};
-            quadInfoBufferInfo.buffer = quadInfoBuffer->getBuffer();
-            quadInfoBufferInfo.offset = 0;
-            quadInfoBufferInfo.range = quadInfos.size() * sizeof(QuadInfo);
-
-            VkDescriptorBufferInfo lightingBufferInfo{};
-            lightingBufferInfo.buffer = bufferManager->getLightingBuffer();
-            lightingBufferInfo.offset = 0;
-            lightingBufferInfo.range = VK_WHOLE_SIZE;
-
-            VkDescriptorBufferInfo chunkDataBufferInfo{};
-            chunkDataBufferInfo.buffer = bufferManager->getChunkDataBuffer();
-            chunkDataBufferInfo.offset = 0;
-            chunkDataBufferInfo.range = VK_WHOLE_SIZE;
-
-            VkDescriptorBufferInfo faceDataBufferInfo{};
-            faceDataBufferInfo.buffer = bufferManager->getFaceBuffer();
-            faceDataBufferInfo.offset = 0;
-            faceDataBufferInfo.range = VK_WHOLE_SIZE;
-
-            VkWriteDescriptorSet descriptorWrites[4]{};
-            descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[0].dstSet = geometryDescriptorSet;
-            descriptorWrites[0].dstBinding = 0;
-            descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-            descriptorWrites[0].descriptorCount = 1;
-            descriptorWrites[0].pBufferInfo = &quadInfoBufferInfo;
-
-            descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[1].dstSet = geometryDescriptorSet;
-            descriptorWrites[1].dstBinding = 1;
-            descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-            descriptorWrites[1].descriptorCount = 1;
-            descriptorWrites[1].pBufferInfo = &lightingBufferInfo;
-
-            descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[2].dstSet = geometryDescriptorSet;
-            descriptorWrites[2].dstBinding = 2;
-            descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-            descriptorWrites[2].descriptorCount = 1;
-            descriptorWrites[2].pBufferInfo = &chunkDataBufferInfo;
-
-            descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[3].dstSet = geometryDescriptorSet;
-            descriptorWrites[3].dstBinding = 3;
-            descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-            descriptorWrites[3].descriptorCount = 1;
-            descriptorWrites[3].pBufferInfo = &faceDataBufferInfo;
-
-            vkUpdateDescriptorSets(vulkanContext->getDevice().getLogicalDevice(), 4, descriptorWrites, 0, nullptr);
-            quadInfoNeedsUpdate = false;
-        }
+    uploadNewQuadInfos(chunkManager);
+
+    // Submit this frame's chunk uploads; drawing waits for them on the GPU, not the CPU
+    uint64_t uploadValue = bufferManager->flushUploads(renderer->getCurrentFrameIndex());
+    if (uploadValue > 0) {
+        renderer->waitForTimeline(bufferManager->getUploadSemaphore(), uploadValue,
+                                  VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT);
     }
 
     auto cmd = renderer->getCurrentCommandBuffer();
@@ -664,13 +682,17 @@ void RenderManager::renderScene(Camera& camera, ChunkManager& chunkManager,
     cmd.pushConstants(mainPipeline->getLayout(), VK_SHADER_STAGE_VERTEX_BIT,
                      0, sizeof(PushConstants), &pushConstants);
 
-    // Render chunks
+    // Render chunks: only those in the view frustum and render distance, nearest first
+    float maxDistance = static_cast<float>(chunkManager.getRenderDistance() * CHUNK_SIZE);
+    bufferManager->prepareDraws(camera.getFrustum(), camera.getPosition(), maxDistance,
+                                renderer->getCurrentFrameIndex());
+
     uint32_t drawCount = bufferManager->getDrawCommandCount();
     if (drawCount > 0) {
         static bool loggedOnce = false;
         if (!loggedOnce) {
-            spdlog::info("Rendering {} chunks with {} draw commands",
-                        bufferManager->getMeshCache().size(), drawCount);
+            spdlog::info("Rendering {} chunks with {} bucket draws for {} chunk slots",
+                        bufferManager->getMeshCache().size(), drawCount, bufferManager->getTotalDrawCommandCount());
             loggedOnce = true;
         }
 
@@ -90,11 +90,6 @@ public:
      */
     ChunkBufferManager& getChunkBufferManager() { return *bufferManager; }
 
-    /**
-     * Mark QuadInfo buffer for update
-     */
-    void markQuadInfoForUpdate() { quadInfoNeedsUpdate = true; }
-
     /**
      * Clear all chunk mesh data from GPU buffers
      */
@@ -109,6 +104,11 @@ public:
 private:
     void createPipelines(TextureManager& textureManager);
     void createBuffers();
+    void writeGeometryDescriptors();
+    void uploadNewQuadInfos(const ChunkManager& chunkManager);
+
+    // QuadInfo buffer is pre-sized and filled append-only (no GPU sync or descriptor rewrites)
+    static constexpr size_t MAX_QUAD_INFOS = 16384;
 
     struct PushConstants {
         glm::mat4 viewProj;
@@ -174,7 +174,7 @@ private:
     uint32_t blurTexture1Index;
 
     // State tracking
-    bool quadInfoNeedsUpdate;
+    size_t uploadedQuadCount;  // QuadInfos [0, uploadedQuadCount) are already in quadInfoBuffer
 };
 
 } // namespace FarHorizon
\ No newline at end of file
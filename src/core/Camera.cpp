@@ -120,6 +120,7 @@ void Camera::updateProjectionMatrix() {
     // Vulkan uses inverted Y clip space compared to OpenGL
     projectionMatrix_ = glm::perspective(glm::radians(fov_), aspectRatio_, nearPlane_, farPlane_);
     projectionMatrix_[1][1] *= -1; // Flip Y for Vulkan
+    updateFrustum();
 }
 
 void Camera::updateVectors() {
@@ -135,6 +136,12 @@ void Camera::updateVectors() {
     // Calculate right and up vectors
     right_ = glm::normalize(glm::cross(forward_, glm::vec3(0.0f, 1.0f, 0.0f)));
     up_ = glm::normalize(glm::cross(right_, forward_));
+    updateFrustum();
+}
+
+void Camera::updateFrustum() {
+    // Only orientation and projection matter: culling works on camera-relative bounds
+    frustum_ = Frustum::fromMatrix(getRotationOnlyViewProjectionMatrix());
 }
 
 } // namespace FarHorizon
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "InputTypes.hpp"
 #include "KeybindAction.hpp"
 #include "MouseCapture.hpp"
+#include "../util/Frustum.hpp"
 #include <unordered_map>
 #include <string>
 
@@ -58,6 +59,9 @@ public:
         return projectionMatrix_ * rotationOnlyView;
     }
 
+    // Frustum planes in the same camera-relative space (camera at the origin)
+    const Frustum& getFrustum() const { return frustum_; }
+
     float getYaw() const { return yaw_; }
     float getPitch() const { return pitch_; }
     float getFov() const { return fov_; }
@@ -66,6 +70,7 @@ private:
     void updateViewMatrix();
     void updateProjectionMatrix();
     void updateVectors();
+    void updateFrustum();
 
 private:
     // Camera position and orientation
@@ -93,6 +98,7 @@ private:
     // Matrices
     glm::mat4 viewMatrix_ = glm::mat4(1.0f);
     glm::mat4 projectionMatrix_ = glm::mat4(1.0f);
+    Frustum frustum_;
 
     // Parsed keybinds (for fast lookup during update)
     KeyCode keyForward_ = KeyCode::W;
@@ -14,6 +14,8 @@ Settings::Settings()
     , menuBlurAmount(ofInt("menuBlurAmount", 1, 0, 10))
     , renderClouds(ofBoolean("renderClouds", false))
     , cloudRange(ofInt("cloudRange", 128, 2, 128))
+    , greedyMeshing(ofBoolean("greedyMeshing", true))
+    , lodDistance(ofInt("lodDistance", 12, 0, 32))
     , soundDevice(ofString("soundDevice", ""))
     , masterVolume(ofFloat("masterVolume", 0.5f, 0.0f, 1.0f))
     , saveChatDrafts(ofBoolean("saveChatDrafts", false))
@@ -34,6 +34,8 @@ public:
     // Rendering options
     SimpleOption<bool> renderClouds;
     SimpleOption<int32_t> cloudRange;
+    SimpleOption<bool> greedyMeshing;
+    SimpleOption<int32_t> lodDistance;  // Chunks before the first LOD ring (rings double outwards), 0 = off
 
     // Audio
     SimpleOption<std::string> soundDevice;
@@ -145,6 +147,8 @@ public:
             parseField("menuBlurAmount", menuBlurAmount);
             parseField("renderClouds", renderClouds);
             parseField("cloudRange", cloudRange);
+            parseField("greedyMeshing", greedyMeshing);
+            parseField("lodDistance", lodDistance);
             parseField("soundDevice", soundDevice);
             parseField("masterVolume", masterVolume);
             parseField("saveChatDrafts", saveChatDrafts);
@@ -230,6 +234,8 @@ public:
             writeField("menuBlurAmount", menuBlurAmount.getValue());
             writeBool("renderClouds", renderClouds.getValue());
             writeField("cloudRange", cloudRange.getValue());
+            writeBool("greedyMeshing", greedyMeshing.getValue());
+            writeField("lodDistance", lodDistance.getValue());
             writeString("soundDevice", soundDevice.getValue());
             writeField("masterVolume", masterVolume.getValue());
             writeBool("saveChatDrafts", saveChatDrafts.getValue());
@@ -17,11 +17,11 @@ bool InteractionManager::breakBlock(const BlockHitResult& hitResult) {
     // Get sound group from registry before breaking
     const BlockSoundGroup& soundGroup = BlockRegistry::getSoundGroup(hitResult.state);
 
-    // Set to air using copy-on-write
-    chunkManager_.setBlockState(hitResult.blockPos, BlockRegistry::AIR->getDefaultState());
-
-    // Notify neighboring blocks that this block was removed
-    chunkManager_.notifyNeighbors(hitResult.blockPos, BlockRegistry::AIR->getDefaultState());
+    // Set to air and notify neighboring blocks, committed as one copy-on-write batch
+    ChunkEditBatch batch(chunkManager_);
+    batch.setBlockState(hitResult.blockPos, BlockRegistry::AIR->getDefaultState());
+    chunkManager_.notifyNeighbors(batch, hitResult.blockPos, BlockRegistry::AIR->getDefaultState());
+    chunkManager_.applyEdits(batch);
 
     // Play break sound
     audioManager_.playSoundEvent(soundGroup.getBreakSound(), soundGroup.getVolume(), soundGroup.getPitch());
@@ -52,11 +52,11 @@ bool InteractionManager::placeBlock(const BlockHitResult& hitResult, Block* bloc
         placedState = calculateStairPlacement(stairBlock, hitResult, cameraForward, placePos);
     }
 
-    // Place the block using copy-on-write
-    chunkManager_.setBlockState(placePos, placedState);
-
-    // Notify neighboring blocks that a new block was placed
-    chunkManager_.notifyNeighbors(placePos, placedState);
+    // Place the block and notify neighboring blocks, committed as one copy-on-write batch
+    ChunkEditBatch batch(chunkManager_);
+    batch.setBlockState(placePos, placedState);
+    chunkManager_.notifyNeighbors(batch, placePos, placedState);
+    chunkManager_.applyEdits(batch);
 
     // Play place sound
     const BlockSoundGroup& soundGroup = BlockRegistry::getSoundGroup(placedState);
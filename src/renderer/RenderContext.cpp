@@ -1,6 +1,7 @@
 #include "RenderContext.hpp"
 #include "core/VulkanDebug.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 namespace FarHorizon {
 
@@ -155,13 +156,22 @@ void RenderContext::endFrame() {
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-    // Wait on per-frame imageAvailable semaphore
-    VkSemaphore waitSemaphores[] = {frame.imageAvailableSemaphore.getSemaphore()};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
+    // Wait on per-frame imageAvailable semaphore, plus the timeline wait if one was requested
+    VkSemaphore waitSemaphores[] = {frame.imageAvailableSemaphore.getSemaphore(), m_timelineWaitSemaphore};
+    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, m_timelineWaitStages};
+    uint64_t waitValues[] = {0, m_timelineWaitValue};  // Binary semaphores ignore their value
+    submitInfo.waitSemaphoreCount = m_timelineWaitSemaphore != VK_NULL_HANDLE ? 2 : 1;
     submitInfo.pWaitSemaphores = waitSemaphores;
     submitInfo.pWaitDstStageMask = waitStages;
 
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount = submitInfo.waitSemaphoreCount;
+    timelineInfo.pWaitSemaphoreValues = waitValues;
+    if (m_timelineWaitSemaphore != VK_NULL_HANDLE) {
+        submitInfo.pNext = &timelineInfo;
+    }
+
     VkCommandBuffer cmdBuffer = cmd.getBuffer();
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &cmdBuffer;
@@ -172,6 +182,9 @@ void RenderContext::endFrame() {
     submitInfo.pSignalSemaphores = signalSemaphores;
 
     VK_CHECK(vkQueueSubmit(m_context->getDevice().getGraphicsQueue(), 1, &submitInfo, frame.renderFence.getFence()));
+    m_timelineWaitSemaphore = VK_NULL_HANDLE;
+    m_timelineWaitValue = 0;
+    m_timelineWaitStages = 0;
 
     // Present, waiting on per-image renderFinished semaphore
     VkResult result = m_swapchain->present(
@@ -192,6 +205,14 @@ void RenderContext::endFrame() {
     m_frameInProgress = false;
 }
 
+void RenderContext::waitForTimeline(VkSemaphore semaphore, uint64_t value, VkPipelineStageFlags stages) {
+    // One timeline per frame is all we need; later calls raise the value
+    assert(m_timelineWaitSemaphore == VK_NULL_HANDLE || m_timelineWaitSemaphore == semaphore);
+    m_timelineWaitSemaphore = semaphore;
+    m_timelineWaitValue = std::max(m_timelineWaitValue, value);
+    m_timelineWaitStages |= stages;
+}
+
 CommandBuffer RenderContext::getCurrentCommandBuffer() const {
     uint32_t frameIndex = m_frameSync.getCurrentFrameIndex();
     return CommandBuffer(m_commandBuffers[frameIndex][0]);
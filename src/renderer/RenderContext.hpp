@@ -32,6 +32,9 @@ public:
     bool beginFrame();  // Returns false if swapchain needs recreation
     void endFrame();
 
+    // Make this frame's submit wait until a timeline semaphore reaches value (e.g. pending buffer uploads)
+    void waitForTimeline(VkSemaphore semaphore, uint64_t value, VkPipelineStageFlags stages);
+
     // Get current frame's command buffer
     CommandBuffer getCurrentCommandBuffer() const;
 
@@ -39,6 +42,7 @@ public:
     VulkanContext& getContext() { return *m_context; }
     Swapchain& getSwapchain() { return *m_swapchain; }
     uint32_t getCurrentImageIndex() const { return m_currentImageIndex; }
+    uint32_t getCurrentFrameIndex() const { return m_frameSync.getCurrentFrameIndex(); }  // Frame-in-flight slot
     StagingBufferPool& getStagingPool() { return m_stagingPool; }
     RingBuffer& getCurrentRingBuffer() { return m_ringBuffers[m_frameSync.getCurrentFrameIndex()]; }
 
@@ -59,6 +63,11 @@ private:
     StagingBufferPool m_stagingPool;
     std::vector<RingBuffer> m_ringBuffers; // One per frame in flight
 
+    // Extra timeline wait for the next submit (VK_NULL_HANDLE if none)
+    VkSemaphore m_timelineWaitSemaphore = VK_NULL_HANDLE;
+    uint64_t m_timelineWaitValue = 0;
+    VkPipelineStageFlags m_timelineWaitStages = 0;
+
     uint32_t m_currentImageIndex = 0;
     bool m_frameInProgress = false;
 };
@@ -138,6 +138,7 @@ void VulkanDevice::createLogicalDevice() {
     vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
     vulkan12Features.runtimeDescriptorArray = VK_TRUE;
     vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    vulkan12Features.timelineSemaphore = VK_TRUE; // Transfer queue -> graphics handoff for chunk uploads
     vulkan12Features.pNext = &vulkan11Features;
 
     // Vulkan 1.3 features struct (includes dynamicRendering and synchronization2)
@@ -185,6 +186,9 @@ void VulkanDevice::createLogicalDevice() {
     spdlog::info("[VulkanDevice] Logical device created");
     spdlog::info("[VulkanDevice] Graphics queue family: {}", m_queueFamilyIndices.graphicsFamily.value());
     spdlog::info("[VulkanDevice] Present queue family: {}", m_queueFamilyIndices.presentFamily.value());
+    if (m_queueFamilyIndices.transferFamily.has_value()) {
+        spdlog::info("[VulkanDevice] Transfer queue family: {}", m_queueFamilyIndices.transferFamily.value());
+    }
 }
 
 void VulkanDevice::shutdown() {
@@ -314,14 +318,14 @@ QueueFamilyIndices VulkanDevice::findQueueFamilies(VkPhysicalDevice device, VkSu
         const auto& queueFamily = queueFamilies[i];
 
         // Graphics queue
-        if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+        if ((queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && !indices.graphicsFamily.has_value()) {
             indices.graphicsFamily = i;
         }
 
         // Present queue
         VkBool32 presentSupport = false;
         vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
-        if (presentSupport) {
+        if (presentSupport && !indices.presentFamily.has_value()) {
             indices.presentFamily = i;
         }
 
@@ -341,9 +345,7 @@ QueueFamilyIndices VulkanDevice::findQueueFamilies(VkPhysicalDevice device, VkSu
             }
         }
 
-        if (indices.isComplete()) {
-            break;
-        }
+        // No early out once graphics/present are found: dedicated compute/transfer families come later
     }
 
     return indices;
@@ -47,7 +47,8 @@ void Buffer::init(
     VkDeviceSize size,
     VkBufferUsageFlags usage,
     VmaMemoryUsage memoryUsage,
-    VmaAllocationCreateFlags flags
+    VmaAllocationCreateFlags flags,
+    const std::vector<uint32_t>& queueFamilies
 ) {
     allocator_ = allocator;
     size_ = size;
@@ -57,6 +58,12 @@ void Buffer::init(
     bufferInfo.size = size;
     bufferInfo.usage = usage;
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (queueFamilies.size() > 1) {
+        // Concurrent sharing avoids queue family ownership transfers (e.g. transfer queue -> graphics)
+        bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size());
+        bufferInfo.pQueueFamilyIndices = queueFamilies.data();
+    }
 
     VmaAllocationCreateInfo allocInfo{};
     allocInfo.usage = memoryUsage;
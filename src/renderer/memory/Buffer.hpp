@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
 #include <cstddef>
+#include <vector>
 
 namespace FarHorizon {
 
@@ -21,12 +22,14 @@ public:
     Buffer& operator=(Buffer&& other) noexcept;
 
     // Create buffer with VMA
+    // queueFamilies: families that access the buffer; two or more distinct ones make it concurrently shared
     void init(
         VmaAllocator allocator,
         VkDeviceSize size,
         VkBufferUsageFlags usage,
         VmaMemoryUsage memoryUsage,
-        VmaAllocationCreateFlags flags = 0
+        VmaAllocationCreateFlags flags = 0,
+        const std::vector<uint32_t>& queueFamilies = {}
     );
 
     void cleanup();
@@ -0,0 +1,185 @@
+#include "BufferUploader.hpp"
+#include "../core/VulkanContext.hpp"
+#include <tracy/Tracy.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <iterator>
+
+namespace FarHorizon {
+
+void BufferUploader::init(VulkanContext& context, VkDeviceSize stagingSize) {
+    const VulkanDevice& device = context.getDevice();
+    const QueueFamilyIndices& indices = device.getQueueFamilyIndices();
+    uint32_t graphicsFamily = indices.graphicsFamily.value();
+    uint32_t transferFamily = indices.transferFamily.value_or(graphicsFamily);
+
+    device_ = device.getLogicalDevice();
+    queue_ = indices.transferFamily.has_value() ? device.getTransferQueue() : device.getGraphicsQueue();
+    stagingSize_ = stagingSize;
+
+    queueFamilies_ = {graphicsFamily};
+    if (transferFamily != graphicsFamily) {
+        queueFamilies_.push_back(transferFamily);
+    }
+
+    stagingPool_.init(context.getAllocator(), stagingSize);
+    commandPool_.init(device_, transferFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+    timeline_.initTimeline(device_);
+
+    spdlog::info("[BufferUploader] Uploading on queue family {} ({})", transferFamily,
+                 transferFamily != graphicsFamily ? "dedicated transfer" : "shared with graphics");
+}
+
+void BufferUploader::cleanup() {
+    if (device_ == VK_NULL_HANDLE) {
+        return;
+    }
+
+    // Staging memory and command buffers may still be in use by the transfer queue
+    if (lastSubmitted_ > 0) {
+        timeline_.wait(lastSubmitted_);
+    }
+    inFlight_.clear();
+    current_ = {};
+    freeCommandBuffers_.clear();
+
+    timeline_.cleanup();
+    commandPool_.cleanup();
+    stagingPool_.cleanup();
+    device_ = VK_NULL_HANDLE;
+}
+
+void BufferUploader::stage(Buffer& dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size) {
+    if (size == 0) {
+        return;
+    }
+
+    // Spill into a new batch when the staging buffer is full (one larger than stagingSize_ holds a big write alone)
+    // or when rewriting a range already staged, since copy regions within one command are unordered
+    if (current_.staging && (current_.used + size > current_.staging->getSize() ||
+                             overlapsStaged(dst.getBuffer(), dstOffset, size))) {
+        submit();
+    }
+    if (!current_.staging) {
+        reclaim();
+        current_.staging = stagingPool_.acquire(std::max(size, stagingSize_));
+    }
+
+    current_.staging->write(data, size, current_.used);
+
+    VkBufferCopy region{};
+    region.srcOffset = current_.used;
+    region.dstOffset = dstOffset;
+    region.size = size;
+    current_.regions[dst.getBuffer()].emplace(dstOffset, region);
+    current_.used += size;
+}
+
+bool BufferUploader::overlapsStaged(VkBuffer dst, VkDeviceSize dstOffset, VkDeviceSize size) const {
+    auto dstIt = current_.regions.find(dst);
+    if (dstIt == current_.regions.end()) {
+        return false;
+    }
+
+    const auto& regions = dstIt->second;
+    auto next = regions.lower_bound(dstOffset);
+    if (next != regions.end() && next->first < dstOffset + size) {
+        return true;
+    }
+    if (next != regions.begin()) {
+        const VkBufferCopy& prev = std::prev(next)->second;
+        return prev.dstOffset + prev.size > dstOffset;
+    }
+    return false;
+}
+
+uint64_t BufferUploader::flush() {
+    if (current_.used > 0) {
+        submit();
+    }
+    reclaim();
+    return lastSubmitted_;
+}
+
+void BufferUploader::submit() {
+    ZoneScoped;
+
+    VkCommandBuffer cmd = VK_NULL_HANDLE;
+    if (!freeCommandBuffers_.empty()) {
+        cmd = freeCommandBuffers_.back();
+        freeCommandBuffers_.pop_back();
+    } else {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = commandPool_.getPool();
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        VK_CHECK(vkAllocateCommandBuffers(device_, &allocInfo, &cmd));
+    }
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VK_CHECK(vkBeginCommandBuffer(cmd, &beginInfo));
+
+    // Earlier batches may have written the same ranges (recycled ranges, metadata slots): order the writes
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    // One copy command per destination buffer, however many chunks were staged
+    std::vector<VkBufferCopy> copies;
+    for (const auto& [dst, regions] : current_.regions) {
+        copies.clear();
+        for (const auto& [dstOffset, region] : regions) {
+            copies.push_back(region);
+        }
+        vkCmdCopyBuffer(cmd, current_.staging->getBuffer(), dst,
+                        static_cast<uint32_t>(copies.size()), copies.data());
+    }
+
+    VK_CHECK(vkEndCommandBuffer(cmd));
+
+    uint64_t signalValue = lastSubmitted_ + 1;
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues = &signalValue;
+
+    VkSemaphore timeline = timeline_.getSemaphore();
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &cmd;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &timeline;
+
+    VK_CHECK(vkQueueSubmit(queue_, 1, &submitInfo, VK_NULL_HANDLE));
+    lastSubmitted_ = signalValue;
+
+    current_.cmd = cmd;
+    current_.timelineValue = signalValue;
+    inFlight_.push_back(std::move(current_));
+    current_ = {};
+}
+
+void BufferUploader::reclaim() {
+    if (inFlight_.empty()) {
+        return;
+    }
+
+    uint64_t completed = timeline_.getCounterValue();
+    while (!inFlight_.empty() && inFlight_.front().timelineValue <= completed) {
+        Batch& batch = inFlight_.front();
+        stagingPool_.release(batch.staging);
+        VK_CHECK(vkResetCommandBuffer(batch.cmd, 0));
+        freeCommandBuffers_.push_back(batch.cmd);
+        inFlight_.pop_front();
+    }
+}
+
+} // namespace FarHorizon
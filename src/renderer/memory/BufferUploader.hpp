@@ -0,0 +1,78 @@
+#pragma once
+
+#include "StagingBufferPool.hpp"
+#include "../command/CommandPool.hpp"
+#include "../sync/Semaphore.hpp"
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace FarHorizon {
+
+class VulkanContext;
+
+// Streams CPU data into device-local buffers
+// Writes are packed into pooled staging buffers and submitted as batched vkCmdCopyBuffer regions
+// on the transfer queue (the graphics queue when the device has no separate transfer family).
+// Each submit signals a timeline semaphore value that consumers wait on before reading.
+// Not thread-safe (owned by the render thread)
+class BufferUploader {
+public:
+    BufferUploader() = default;
+    ~BufferUploader() { cleanup(); }
+
+    // No copy
+    BufferUploader(const BufferUploader&) = delete;
+    BufferUploader& operator=(const BufferUploader&) = delete;
+
+    // stagingSize: size of each pooled staging buffer (a batch spills into a new one when full)
+    void init(VulkanContext& context, VkDeviceSize stagingSize);
+    void cleanup();
+
+    // Queue families that access buffers written by this uploader (pass to Buffer::init)
+    const std::vector<uint32_t>& getQueueFamilies() const { return queueFamilies_; }
+
+    // Copy data into dst at dstOffset with the next flush()
+    // Writes to the same range land in staging order
+    void stage(Buffer& dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size);
+
+    // Submit everything staged since the last flush
+    // Returns the timeline value that covers all uploads so far (0 if nothing was ever submitted)
+    uint64_t flush();
+
+    VkSemaphore getTimelineSemaphore() const { return timeline_.getSemaphore(); }
+
+private:
+    // Staging buffer being filled, or submitted and waiting for its timeline value
+    struct Batch {
+        StagingBuffer* staging = nullptr;
+        VkDeviceSize used = 0;
+        // Per destination buffer, keyed by dstOffset (regions of one copy command must not overlap)
+        std::unordered_map<VkBuffer, std::map<VkDeviceSize, VkBufferCopy>> regions;
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        uint64_t timelineValue = 0;
+    };
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkQueue queue_ = VK_NULL_HANDLE;
+    std::vector<uint32_t> queueFamilies_;
+    VkDeviceSize stagingSize_ = 0;
+
+    StagingBufferPool stagingPool_;
+    CommandPool commandPool_;
+    std::vector<VkCommandBuffer> freeCommandBuffers_;
+    Semaphore timeline_;
+    uint64_t lastSubmitted_ = 0;
+
+    Batch current_;
+    std::deque<Batch> inFlight_;
+
+    // Submit current_ and start an empty one
+    void submit();
+    bool overlapsStaged(VkBuffer dst, VkDeviceSize dstOffset, VkDeviceSize size) const;
+    // Return staging buffers and command buffers of batches the transfer queue has finished
+    void reclaim();
+};
+
+} // namespace FarHorizon
@@ -1,20 +1,61 @@
 #include "ChunkBufferManager.hpp"
 #include <tracy/Tracy.hpp>
+#include "../sync/FrameSync.hpp"
+#include "../core/VulkanContext.hpp"
+#include "../../world/FaceUtils.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
 
 namespace FarHorizon {
 
-void ChunkBufferManager::init(VmaAllocator allocator, size_t maxFaces, size_t maxDrawCommands) {
+// Freed ranges are recycled once every frame that could still read them has finished
+static constexpr uint64_t RETIRE_FRAMES = FrameSync::MAX_FRAMES_IN_FLIGHT + 1;
+// Defragment only once the face buffer is half used and at least this much of it is holes
+static constexpr float DEFRAG_MIN_USAGE = 0.5f;
+static constexpr float DEFRAG_HOLE_FRACTION = 0.25f;
+// Chunks tried per defragment() call that found no lower hole before giving up
+static constexpr int DEFRAG_MAX_MISSES = 64;
+// Size of each staging buffer the uploader cycles through
+static constexpr VkDeviceSize UPLOAD_STAGING_SIZE = 16 * 1024 * 1024;
+
+// A face pointing along +axis can only be seen from in front of its plane, which lies at or above the
+// chunk's bounds minimum on that axis (at or below the maximum for -axis); the rasterizer culls back faces
+static bool isBucketFacingCamera(int bucket, const glm::ivec3& boundsMin, const glm::ivec3& boundsMax,
+                                 const glm::vec3& cameraPos) {
+    if (bucket == FACE_BUCKET_UNALIGNED) {
+        return true;
+    }
+    glm::vec3 normal = FaceUtils::getFaceNormal(FaceUtils::fromIndex(bucket));
+    for (int axis = 0; axis < 3; axis++) {
+        if (normal[axis] > 0.0f) {
+            return cameraPos[axis] > static_cast<float>(boundsMin[axis]);
+        }
+        if (normal[axis] < 0.0f) {
+            return cameraPos[axis] < static_cast<float>(boundsMax[axis]);
+        }
+    }
+    return true;
+}
+
+void ChunkBufferManager::init(VulkanContext& context, size_t maxFaces, size_t maxDrawCommands) {
     maxFaces_ = maxFaces;
     maxDrawCommands_ = maxDrawCommands;
 
+    VmaAllocator allocator = context.getAllocator();
+    uploader_.init(context, UPLOAD_STAGING_SIZE);
+
+    // Face, lighting and metadata buffers live in device memory and are only written by the uploader
+    // Shared by the graphics and transfer families, so no ownership transfers are needed
+
     // FaceData buffer (8 bytes per face, used as SSBO)
     faceBuffer_.init(
         allocator,
         maxFaces * sizeof(FaceData),
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU,
-        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+        VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+        0,
+        uploader_.getQueueFamilies()
     );
 
     // Lighting buffer (16 bytes per face)
@@ -22,336 +63,430 @@ void ChunkBufferManager::init(VmaAllocator allocator, size_t maxFaces, size_t ma
         allocator,
         maxFaces * sizeof(PackedLighting),
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU,
-        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+        VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+        0,
+        uploader_.getQueueFamilies()
     );
 
-    // Indirect draw buffer (non-indexed instanced drawing)
-    indirectBuffer_.init(
-        allocator,
-        maxDrawCommands * sizeof(VkDrawIndirectCommand),
-        VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU,
-        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
-    );
+    // Indirect draw buffers (non-indexed instanced drawing)
+    // Host-visible and one per frame in flight: the visible set is rebuilt every frame
+    for (Buffer& indirectBuffer : indirectBuffers_) {
+        indirectBuffer.init(
+            allocator,
+            maxDrawCommands * FACE_BUCKET_COUNT * sizeof(VkDrawIndirectCommand),
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            VMA_MEMORY_USAGE_CPU_TO_GPU,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+        );
+    }
 
     // ChunkGpuMetadata buffer (per-chunk metadata, indexed by gl_BaseInstance)
+    // One copy per frame in flight, so a frame's metadata is never rewritten while the GPU reads it
     chunkDataBuffer_.init(
         allocator,
-        maxDrawCommands * sizeof(ChunkGpuMetadata),
+        FrameSync::MAX_FRAMES_IN_FLIGHT * maxDrawCommands * sizeof(ChunkGpuMetadata),
         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        VMA_MEMORY_USAGE_CPU_TO_GPU,
-        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT
+        VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+        0,
+        uploader_.getQueueFamilies()
     );
 
+    faceAllocator_.reset(static_cast<uint32_t>(maxFaces));
+    lightingAllocator_.reset(static_cast<uint32_t>(maxFaces));
+
     // Reserve space for chunk data array
     chunkDataArray_.reserve(maxDrawCommands);
+    chunkDraws_.reserve(maxDrawCommands);
 
     spdlog::info("ChunkBufferManager initialized: {} max faces, {} max draw commands", maxFaces, maxDrawCommands);
 }
 
 void ChunkBufferManager::cleanup() {
+    uploader_.cleanup();
     chunkDataBuffer_.cleanup();
-    indirectBuffer_.cleanup();
+    for (Buffer& indirectBuffer : indirectBuffers_) {
+        indirectBuffer.cleanup();
+    }
     lightingBuffer_.cleanup();
     faceBuffer_.cleanup();
     meshCache_.clear();
     allocations_.clear();
-    chunkDataArray_.clear();
+    meshSequences_.clear();
+    visibilityGraph_.clear();
+    resizeDrawCommands(0);
+    freeSlots_.clear();
+    slotCount_ = 0;
+    retiredRanges_.clear();
 }
 
 void ChunkBufferManager::clear() {
     meshCache_.clear();
     allocations_.clear();
-    chunkDataArray_.clear();
-    currentFaceOffset_ = 0;
-    currentLightingOffset_ = 0;
-    drawCommandCount_ = 0;
+    meshSequences_.clear();
+    visibilityGraph_.clear();
+    resizeDrawCommands(0);
+    faceAllocator_.reset(static_cast<uint32_t>(maxFaces_));
+    lightingAllocator_.reset(static_cast<uint32_t>(maxFaces_));
+    retiredRanges_.clear();
+    freeSlots_.clear();
+    slotCount_ = 0;
+    visibleDrawCount_ = 0;
+    metadataDirty_.fill({});
     spdlog::info("Cleared all chunk meshes from GPU buffers");
 }
 
-bool ChunkBufferManager::addMeshes(std::vector<CompactChunkMesh>& meshes, size_t maxPerFrame) {
-    ZoneScoped;
-    if (meshes.empty()) return true;
+void ChunkBufferManager::beginFrame() {
+    frameIndex_++;
+    while (!retiredRanges_.empty() && retiredRanges_.front().frame + RETIRE_FRAMES <= frameIndex_) {
+        const RetiredRange& range = retiredRanges_.front();
+        (range.lighting ? lightingAllocator_ : faceAllocator_).free(range.offset, range.count);
+        retiredRanges_.pop_front();
+    }
+}
 
-    size_t processCount = std::min(meshes.size(), maxPerFrame);
-    size_t actualProcessed = 0;
-    bool needsDrawCommandRebuild = false;
+void ChunkBufferManager::retire(bool lighting, uint32_t offset, uint32_t count) {
+    if (count > 0) {
+        retiredRanges_.push_back({frameIndex_, offset, count, lighting});
+    }
+}
 
-    // Map buffers once for all updates
-    void* faceData = faceBuffer_.map();
-    void* lightingData = lightingBuffer_.map();
-    void* indirectData = indirectBuffer_.map();
-    void* chunkData = chunkDataBuffer_.map();
+void ChunkBufferManager::retireAllocation(const ChunkBufferAllocation& allocation) {
+    retire(false, allocation.faceOffset, allocation.faceCount);
+    retire(true, allocation.lightingOffset, allocation.lightingCount);
+}
 
-    for (size_t i = 0; i < processCount; i++) {
-        CompactChunkMesh& mesh = meshes[i];
+bool ChunkBufferManager::allocateRanges(uint32_t faceCount, uint32_t lightingCount,
+                                        ChunkBufferAllocation& allocation) {
+    uint32_t faceOffset = faceAllocator_.allocate(faceCount);
+    uint32_t lightingOffset = lightingAllocator_.allocate(lightingCount);
+    if (faceOffset == RangeAllocator::INVALID_OFFSET || lightingOffset == RangeAllocator::INVALID_OFFSET) {
+        // Never written, so the successful half can be reused right away
+        if (faceOffset != RangeAllocator::INVALID_OFFSET) {
+            faceAllocator_.free(faceOffset, faceCount);
+        }
+        if (lightingOffset != RangeAllocator::INVALID_OFFSET) {
+            lightingAllocator_.free(lightingOffset, lightingCount);
+        }
+        return false;
+    }
 
-        // Check if this chunk already has a mesh (update case)
-        auto existingIt = allocations_.find(mesh.position);
-        bool isUpdate = (existingIt != allocations_.end());
+    allocation.faceOffset = faceOffset;
+    allocation.faceCount = faceCount;
+    allocation.lightingOffset = lightingOffset;
+    allocation.lightingCount = lightingCount;
+    return true;
+}
 
-        // If updating and new mesh is empty, mark old allocation as unused and remove from cache
-        if (isUpdate && mesh.faces.empty()) {
-            allocations_.erase(existingIt);
-            meshCache_.erase(mesh.position);
-            actualProcessed++;
-            needsDrawCommandRebuild = true;
-            continue;
+void ChunkBufferManager::writeMeshData(const CompactChunkMesh& mesh, const ChunkBufferAllocation& allocation) {
+    // Write FaceData as-is: light indices stay chunk-local (the shader adds lightingOffset)
+    uploader_.stage(faceBuffer_, allocation.faceOffset * sizeof(FaceData), mesh.faces.data(),
+                    mesh.faces.size() * sizeof(FaceData));
+
+    // Write lighting data
+    uploader_.stage(lightingBuffer_, allocation.lightingOffset * sizeof(PackedLighting), mesh.lighting.data(),
+                    mesh.lighting.size() * sizeof(PackedLighting));
+}
+
+void ChunkBufferManager::writeDrawCommand(const ChunkPosition& pos, const ChunkBufferAllocation& allocation) {
+    uint32_t slot = allocation.drawCommandIndex;
+
+    // Draw commands themselves are built by prepareDraws() from the visible chunks and buckets
+    glm::ivec3 origin(pos.x * CHUNK_SIZE, pos.y * CHUNK_SIZE, pos.z * CHUNK_SIZE);
+    ChunkDraw& draw = chunkDraws_[slot];
+    draw.boundsMin = origin + allocation.boundsMin;
+    draw.boundsMax = origin + allocation.boundsMax;
+    draw.bucketCounts = allocation.bucketCounts;
+    culler_.setBounds(slot, draw.boundsMin, draw.boundsMax);
+
+    // Store ChunkGpuMetadata; each frame's copy picks it up in that frame's flushUploads()
+    chunkDataArray_[slot] = ChunkGpuMetadata::create(pos, allocation.faceOffset, allocation.lightingOffset);
+    for (MetadataSpan& dirty : metadataDirty_) {
+        dirty.begin = std::min(dirty.begin, slot);
+        dirty.end = std::max(dirty.end, slot + 1);
+    }
+}
+
+uint32_t ChunkBufferManager::acquireSlot() {
+    if (!freeSlots_.empty()) {
+        uint32_t slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        return slot;
+    }
+    resizeDrawCommands(slotCount_ + 1);
+    return slotCount_++;
+}
+
+void ChunkBufferManager::releaseSlot(uint32_t slot) {
+    // No draws until reused; frames in flight keep their own metadata and indirect commands for it
+    chunkDraws_[slot] = {};
+    culler_.setBounds(slot, glm::ivec3(0), glm::ivec3(0));
+    freeSlots_.push_back(slot);
+}
+
+void ChunkBufferManager::resizeDrawCommands(size_t count) {
+    chunkDataArray_.resize(count);
+    chunkDraws_.resize(count);
+    culler_.resize(count);
+}
+
+void ChunkBufferManager::prepareDraws(const Frustum& frustum, const glm::vec3& cameraPos, float maxDistance,
+                                      uint32_t frameSlot) {
+    ZoneScoped;
+    culler_.cull(frustum, cameraPos, maxDistance, visibleDraws_);
+
+    // Drop chunks hidden behind terrain: the walk's radius covers every chunk the culler can keep
+    int32_t radius = static_cast<int32_t>(std::ceil(maxDistance / CHUNK_SIZE)) + 1;
+    visibilityGraph_.traverse(frustum, cameraPos, radius, reachableChunks_);
+    reachableSlots_.assign(slotCount_, 0);
+    for (const ChunkPosition& pos : reachableChunks_) {
+        auto it = allocations_.find(pos);
+        if (it != allocations_.end()) {
+            reachableSlots_[it->second.drawCommandIndex] = 1;
         }
+    }
+    std::erase_if(visibleDraws_, [&](uint32_t slot) { return !reachableSlots_[slot]; });
+
+    indirectSlot_ = frameSlot;
+    uint32_t metadataBase = frameSlot * static_cast<uint32_t>(maxDrawCommands_);
+    auto* commands = static_cast<VkDrawIndirectCommand*>(indirectBuffers_[frameSlot].map());
+    uint32_t count = 0;
+    for (uint32_t slot : visibleDraws_) {
+        const ChunkDraw& draw = chunkDraws_[slot];
+
+        // Instanced non-indexed: 6 vertices per face, one instance per face. firstVertex carries the
+        // bucket's first face (the shader adds gl_VertexIndex / 6), firstInstance the chunk's metadata in this
+        // frame's copy for gl_BaseInstance
+        uint32_t bucketStart = 0;
+        for (int bucket = 0; bucket < FACE_BUCKET_COUNT; bucket++) {
+            uint32_t faceCount = draw.bucketCounts[bucket];
+            if (faceCount > 0 && isBucketFacingCamera(bucket, draw.boundsMin, draw.boundsMax, cameraPos)) {
+                VkDrawIndirectCommand& cmd = commands[count++];
+                cmd.vertexCount = 6;
+                cmd.instanceCount = faceCount;
+                cmd.firstVertex = bucketStart * 6;
+                cmd.firstInstance = metadataBase + slot;
+            }
+            bucketStart += faceCount;
+        }
+    }
+    indirectBuffers_[frameSlot].unmap();
 
-        // Skip if mesh is empty and not updating (new empty chunk)
-        if (mesh.faces.empty()) {
+    visibleDrawCount_ = count;
+}
+
+uint64_t ChunkBufferManager::flushUploads(uint32_t frameSlot) {
+    ZoneScoped;
+
+    // Metadata changes are scattered single slots, so send the dirty span as one region
+    // Only frameSlot's copy: the frame that last read it has finished
+    MetadataSpan& dirty = metadataDirty_[frameSlot];
+    if (dirty.begin < dirty.end) {
+        VkDeviceSize base = static_cast<VkDeviceSize>(frameSlot) * maxDrawCommands_;
+        uploader_.stage(chunkDataBuffer_, (base + dirty.begin) * sizeof(ChunkGpuMetadata),
+                        chunkDataArray_.data() + dirty.begin,
+                        (dirty.end - dirty.begin) * sizeof(ChunkGpuMetadata));
+        dirty = {};
+    }
+
+    return uploader_.flush();
+}
+
+size_t ChunkBufferManager::addMeshes(std::vector<CompactChunkMesh>& meshes, size_t byteBudget) {
+    ZoneScoped;
+    if (meshes.empty()) return 0;
+
+    size_t actualProcessed = 0;
+    size_t uploadedBytes = 0;
+    bool bufferFull = false;
+
+    for (size_t i = 0; i < meshes.size(); i++) {
+        CompactChunkMesh& mesh = meshes[i];
+
+        // Drop meshes built from older data than the one already uploaded (workers finish out of order)
+        auto sequenceIt = meshSequences_.find(mesh.position);
+        if (sequenceIt != meshSequences_.end() && mesh.sequence < sequenceIt->second) {
             actualProcessed++;
             continue;
         }
 
-        // If updating, remove old allocation first (we'll add the new one below)
-        if (isUpdate) {
-            allocations_.erase(existingIt);
-            meshCache_.erase(mesh.position);
-            needsDrawCommandRebuild = true;
-        }
-
-        // Check if we have space
-        if (currentFaceOffset_ + mesh.faces.size() > maxFaces_ ||
-            drawCommandCount_ >= maxDrawCommands_) {
-            spdlog::warn("Buffer full, cannot add more meshes");
+        size_t bytes = mesh.faces.size() * sizeof(FaceData) + mesh.lighting.size() * sizeof(PackedLighting);
+        if (uploadedBytes > 0 && uploadedBytes + bytes > byteBudget) {
             break;
         }
 
-        // Write FaceData: copy then adjust lightIndex from local to global
-        FaceData* destFaces = static_cast<FaceData*>(faceData) + currentFaceOffset_;
-        memcpy(destFaces, mesh.faces.data(), mesh.faces.size() * sizeof(FaceData));
+        // Check if this chunk already has a mesh (update case)
+        auto existingIt = allocations_.find(mesh.position);
+        bool isUpdate = (existingIt != allocations_.end());
 
-        // Adjust lightIndex from local (chunk-relative) to global (buffer-relative)
-        for (size_t j = 0; j < mesh.faces.size(); j++) {
-            uint32_t localLightIndex = (destFaces[j].packed1 >> 16) & 0xFFFF;
-            uint32_t globalLightIndex = currentLightingOffset_ + localLightIndex;
-            destFaces[j].packed1 = (destFaces[j].packed1 & 0xFFFF) | (globalLightIndex << 16);
+        // Empty mesh: release the old ranges and draw command, if any
+        if (mesh.faces.empty()) {
+            if (isUpdate) {
+                retireAllocation(existingIt->second);
+                releaseSlot(existingIt->second.drawCommandIndex);
+                allocations_.erase(existingIt);
+                meshCache_.erase(mesh.position);
+            }
+            meshSequences_[mesh.position] = mesh.sequence;
+            visibilityGraph_.set(mesh.position, mesh.connectivity);  // Empty chunks still pass sight through
+            actualProcessed++;
+            continue;
         }
 
-        // Write lighting data
-        memcpy(static_cast<uint8_t*>(lightingData) + currentLightingOffset_ * sizeof(PackedLighting),
-               mesh.lighting.data(),
-               mesh.lighting.size() * sizeof(PackedLighting));
-
-        // Create and store ChunkGpuMetadata (indexed by gl_BaseInstance = drawCommandIndex)
-        // faceOffset == lightingOffset since they're both incremented by the same amount
-        ChunkGpuMetadata chunkMetadata = ChunkGpuMetadata::create(mesh.position, currentFaceOffset_);
-        chunkDataArray_.push_back(chunkMetadata);
-        memcpy(static_cast<uint8_t*>(chunkData) + drawCommandCount_ * sizeof(ChunkGpuMetadata),
-               &chunkMetadata,
-               sizeof(ChunkGpuMetadata));
-
-        // Create draw command (instanced non-indexed: 6 vertices per face)
-        VkDrawIndirectCommand cmd{};
-        cmd.vertexCount = 6;  // 2 triangles per quad (6 vertices total)
-        cmd.instanceCount = static_cast<uint32_t>(mesh.faces.size());  // One instance per face
-        cmd.firstVertex = 0;
-        cmd.firstInstance = drawCommandCount_;  // Chunk ID for gl_BaseInstance (indexes into ChunkData buffer)
-
-        memcpy(static_cast<uint8_t*>(indirectData) + drawCommandCount_ * sizeof(VkDrawIndirectCommand),
-               &cmd,
-               sizeof(VkDrawIndirectCommand));
-
-        // Store allocation info
-        ChunkBufferAllocation allocation;
-        allocation.faceOffset = currentFaceOffset_;
-        allocation.faceCount = static_cast<uint32_t>(mesh.faces.size());
-        allocation.lightingOffset = currentLightingOffset_;
-        allocation.drawCommandIndex = drawCommandCount_;
-
-        allocations_[mesh.position] = allocation;
-
-        // Important: increment lighting offset by number of unique lighting values, not faces!
+        uint32_t faceCount = static_cast<uint32_t>(mesh.faces.size());
         uint32_t lightingCount = static_cast<uint32_t>(mesh.lighting.size());
-        currentFaceOffset_ += allocation.faceCount;
-        currentLightingOffset_ += lightingCount;  // Number of unique lighting values
-        drawCommandCount_++;
+
+        if (isUpdate) {
+            // Frames in flight still draw the old ranges with their old bucket counts, so the new mesh
+            // goes to fresh ranges and the old ones are retired like any freed range
+            ChunkBufferAllocation& allocation = existingIt->second;
+            ChunkBufferAllocation previous = allocation;
+            if (!allocateRanges(faceCount, lightingCount, allocation)) {
+                // Drop the chunk until there is space for it
+                retireAllocation(previous);
+                releaseSlot(previous.drawCommandIndex);
+                allocations_.erase(existingIt);
+                meshCache_.erase(mesh.position);
+                bufferFull = true;
+                actualProcessed++;
+                break;
+            }
+            retireAllocation(previous);
+            allocation.boundsMin = mesh.boundsMin;
+            allocation.boundsMax = mesh.boundsMax;
+            allocation.bucketCounts = mesh.bucketCounts;
+
+            writeMeshData(mesh, allocation);
+            writeDrawCommand(mesh.position, allocation);
+        } else {
+            if (freeSlots_.empty() && slotCount_ >= maxDrawCommands_) {
+                bufferFull = true;
+                actualProcessed++;
+                break;
+            }
+
+            ChunkBufferAllocation allocation;
+            if (!allocateRanges(faceCount, lightingCount, allocation)) {
+                bufferFull = true;
+                actualProcessed++;
+                break;
+            }
+
+            allocation.drawCommandIndex = acquireSlot();
+            allocation.boundsMin = mesh.boundsMin;
+            allocation.boundsMax = mesh.boundsMax;
+            allocation.bucketCounts = mesh.bucketCounts;
+
+            writeMeshData(mesh, allocation);
+            writeDrawCommand(mesh.position, allocation);
+            allocations_[mesh.position] = allocation;
+        }
+
+        meshSequences_[mesh.position] = mesh.sequence;
+        visibilityGraph_.set(mesh.position, mesh.connectivity);
+        uploadedBytes += bytes;
         actualProcessed++;
 
         meshCache_[mesh.position] = std::move(mesh);
     }
 
-    lightingBuffer_.unmap();
-    chunkDataBuffer_.unmap();
-    faceBuffer_.unmap();
-    indirectBuffer_.unmap();
-
-    // Rebuild draw commands if any chunks were removed/updated
-    if (needsDrawCommandRebuild) {
-        rebuildDrawCommands();
+    if (bufferFull) {
+        spdlog::warn("Buffer full, dropping mesh ({} faces used, {} largest free range)",
+                     faceAllocator_.getUsed(), faceAllocator_.getLargestFreeRange());
     }
 
-    spdlog::trace("Added {} chunks to buffer ({} total)", actualProcessed, meshCache_.size());
-    return true;
+    spdlog::trace("Added {} chunks to buffer ({} KB, {} total)", actualProcessed, uploadedBytes / 1024,
+                  meshCache_.size());
+    return actualProcessed;
 }
 
 void ChunkBufferManager::removeUnloadedChunks(const ChunkManager& chunkManager) {
     std::vector<ChunkPosition> toRemove;
 
-    for (const auto& [pos, allocation] : allocations_) {
+    // meshSequences_ also covers chunks whose latest mesh was empty
+    for (const auto& [pos, sequence] : meshSequences_) {
         if (!chunkManager.hasChunk(pos)) {
             toRemove.push_back(pos);
         }
     }
 
     if (!toRemove.empty()) {
+        size_t removedMeshes = 0;
         for (const auto& pos : toRemove) {
+            auto it = allocations_.find(pos);
+            if (it != allocations_.end()) {
+                // Other slots keep their numbers, so no metadata is re-uploaded
+                retireAllocation(it->second);
+                releaseSlot(it->second.drawCommandIndex);
+                allocations_.erase(it);
+                removedMeshes++;
+            }
             meshCache_.erase(pos);
-            allocations_.erase(pos);
+            meshSequences_.erase(pos);
+            visibilityGraph_.erase(pos);
+        }
+        if (removedMeshes > 0) {
+            spdlog::debug("Removed {} unloaded chunks from buffer", removedMeshes);
         }
-        spdlog::debug("Removed {} unloaded chunks from buffer", toRemove.size());
-
-        // Fast rebuild: only updates draw commands, leaves face/lighting data fragmented
-        rebuildDrawCommands();
     }
 }
 
-void ChunkBufferManager::compactIfNeeded(const std::unordered_map<ChunkPosition, CompactChunkMesh, ChunkPositionHash>& meshCache) {
-    // Calculate active space
-    size_t totalActiveFaces = 0;
-    for (const auto& [pos, allocation] : allocations_) {
-        totalActiveFaces += allocation.faceCount;
-    }
-
-    // Check if compaction is needed
-    bool needsCompaction = false;
-    if (currentFaceOffset_ > maxFaces_ * 0.7f) {
-        float faceFragmentation = 1.0f - (static_cast<float>(totalActiveFaces) / currentFaceOffset_);
+void ChunkBufferManager::defragment(size_t byteBudget) {
+    ZoneScoped;
 
-        if (faceFragmentation > 0.3f) {
-            needsCompaction = true;
-            spdlog::debug("Buffer compaction needed: {:.1f}% face fragmentation",
-                         faceFragmentation * 100);
-        }
+    // Holes below the highest allocation; compact only once they waste a good part of the buffer
+    uint32_t end = faceAllocator_.getEnd();
+    uint32_t holes = end - faceAllocator_.getUsed();
+    if (end < faceAllocator_.getCapacity() * DEFRAG_MIN_USAGE || holes < end * DEFRAG_HOLE_FRACTION) {
+        return;
     }
 
-    if (needsCompaction) {
-        fullRebuild();
+    // Highest chunks first: moving them down lowers the end of the used region
+    std::vector<std::pair<uint32_t, ChunkPosition>> candidates;
+    candidates.reserve(allocations_.size());
+    for (const auto& [pos, allocation] : allocations_) {
+        candidates.emplace_back(allocation.faceOffset, pos);
     }
-}
-
-void ChunkBufferManager::fullRebuild() {
-    currentFaceOffset_ = 0;
-    currentLightingOffset_ = 0;
-    drawCommandCount_ = 0;
-    chunkDataArray_.clear();
-
-    void* faceData = faceBuffer_.map();
-    void* lightingData = lightingBuffer_.map();
-    void* indirectData = indirectBuffer_.map();
-    void* chunkData = chunkDataBuffer_.map();
-
-    std::unordered_map<ChunkPosition, ChunkBufferAllocation, ChunkPositionHash> newAllocations;
-
-    for (const auto& [pos, mesh] : meshCache_) {
-        if (mesh.faces.empty()) continue;
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    size_t movedBytes = 0;
+    size_t movedChunks = 0;
+    int misses = 0;
+    for (const auto& [offset, pos] : candidates) {
+        ChunkBufferAllocation& allocation = allocations_[pos];
+        size_t bytes = allocation.faceCount * sizeof(FaceData) + allocation.lightingCount * sizeof(PackedLighting);
+        if (movedBytes + bytes > byteBudget || misses >= DEFRAG_MAX_MISSES) {
+            break;
+        }
 
-        // Write FaceData: copy then adjust lightIndex from local to global
-        FaceData* destFaces = static_cast<FaceData*>(faceData) + currentFaceOffset_;
-        memcpy(destFaces, mesh.faces.data(), mesh.faces.size() * sizeof(FaceData));
+        // Only ever move down, so every move shrinks the used region
+        uint32_t newFaceOffset = faceAllocator_.allocateBelow(allocation.faceCount, allocation.faceOffset);
+        uint32_t newLightingOffset = lightingAllocator_.allocateBelow(allocation.lightingCount, allocation.lightingOffset);
+        if (newFaceOffset == RangeAllocator::INVALID_OFFSET && newLightingOffset == RangeAllocator::INVALID_OFFSET) {
+            misses++;
+            continue;
+        }
 
-        // Adjust lightIndex from local (chunk-relative) to global (buffer-relative)
-        for (size_t j = 0; j < mesh.faces.size(); j++) {
-            uint32_t localLightIndex = (destFaces[j].packed1 >> 16) & 0xFFFF;
-            uint32_t globalLightIndex = currentLightingOffset_ + localLightIndex;
-            destFaces[j].packed1 = (destFaces[j].packed1 & 0xFFFF) | (globalLightIndex << 16);
+        if (newFaceOffset != RangeAllocator::INVALID_OFFSET) {
+            retire(false, allocation.faceOffset, allocation.faceCount);
+            allocation.faceOffset = newFaceOffset;
+        }
+        if (newLightingOffset != RangeAllocator::INVALID_OFFSET) {
+            retire(true, allocation.lightingOffset, allocation.lightingCount);
+            allocation.lightingOffset = newLightingOffset;
         }
 
-        // Write lighting data
-        memcpy(static_cast<uint8_t*>(lightingData) + currentLightingOffset_ * sizeof(PackedLighting),
-               mesh.lighting.data(),
-               mesh.lighting.size() * sizeof(PackedLighting));
-
-        // Create and store ChunkGpuMetadata (indexed by gl_BaseInstance = drawCommandIndex)
-        // faceOffset == lightingOffset since they're both incremented by the same amount
-        ChunkGpuMetadata chunkMetadata = ChunkGpuMetadata::create(mesh.position, currentFaceOffset_);
-        chunkDataArray_.push_back(chunkMetadata);
-        memcpy(static_cast<uint8_t*>(chunkData) + drawCommandCount_ * sizeof(ChunkGpuMetadata),
-               &chunkMetadata,
-               sizeof(ChunkGpuMetadata));
-
-        // Create draw command
-        VkDrawIndirectCommand cmd{};
-        cmd.vertexCount = 6;
-        cmd.instanceCount = static_cast<uint32_t>(mesh.faces.size());
-        cmd.firstVertex = 0;
-        cmd.firstInstance = drawCommandCount_;  // Chunk ID for gl_BaseInstance (indexes into ChunkData buffer)
-
-        memcpy(static_cast<uint8_t*>(indirectData) + drawCommandCount_ * sizeof(VkDrawIndirectCommand),
-               &cmd,
-               sizeof(VkDrawIndirectCommand));
-
-        // Store allocation
-        ChunkBufferAllocation allocation;
-        allocation.faceOffset = currentFaceOffset_;
-        allocation.faceCount = static_cast<uint32_t>(mesh.faces.size());
-        allocation.lightingOffset = currentLightingOffset_;
-        allocation.drawCommandIndex = drawCommandCount_;
-
-        newAllocations[pos] = allocation;
-
-        // Important: increment lighting offset by number of unique lighting values, not faces!
-        uint32_t lightingCount = static_cast<uint32_t>(mesh.lighting.size());
-        currentFaceOffset_ += allocation.faceCount;
-        currentLightingOffset_ += lightingCount;  // Number of unique lighting values
-        drawCommandCount_++;
+        // Re-upload from the CPU copy (a GPU-side copy would need the old range to stay valid until it ran)
+        writeMeshData(meshCache_.at(pos), allocation);
+        writeDrawCommand(pos, allocation);
+        movedBytes += bytes;
+        movedChunks++;
     }
 
-    allocations_ = std::move(newAllocations);
-
-    lightingBuffer_.unmap();
-    chunkDataBuffer_.unmap();
-    faceBuffer_.unmap();
-    indirectBuffer_.unmap();
-
-    spdlog::debug("Buffer compacted: {} chunks, {} faces",
-                 meshCache_.size(), currentFaceOffset_);
-}
-
-void ChunkBufferManager::rebuildDrawCommands() {
-    // Fast path: only rebuild draw commands and chunk metadata
-    // Face data and lighting data remain in place (potentially fragmented)
-    // This is MUCH faster than fullRebuild() when unloading chunks
-
-    drawCommandCount_ = 0;
-    chunkDataArray_.clear();
-
-    void* indirectData = indirectBuffer_.map();
-    void* chunkData = chunkDataBuffer_.map();
-
-    // Rebuild draw commands for remaining allocations
-    for (auto& [pos, allocation] : allocations_) {
-        // Create draw command pointing to existing face/lighting data
-        VkDrawIndirectCommand cmd{};
-        cmd.vertexCount = 6;
-        cmd.instanceCount = allocation.faceCount;
-        cmd.firstVertex = 0;
-        cmd.firstInstance = drawCommandCount_;  // New sequential index
-
-        memcpy(static_cast<uint8_t*>(indirectData) + drawCommandCount_ * sizeof(VkDrawIndirectCommand),
-               &cmd,
-               sizeof(VkDrawIndirectCommand));
-
-        // Create chunk metadata pointing to existing face data
-        ChunkGpuMetadata chunkMetadata = ChunkGpuMetadata::create(pos, allocation.faceOffset);
-        chunkDataArray_.push_back(chunkMetadata);
-        memcpy(static_cast<uint8_t*>(chunkData) + drawCommandCount_ * sizeof(ChunkGpuMetadata),
-               &chunkMetadata,
-               sizeof(ChunkGpuMetadata));
-
-        // Update allocation with new draw command index
-        allocation.drawCommandIndex = drawCommandCount_;
-        drawCommandCount_++;
+    if (movedChunks > 0) {
+        spdlog::debug("Defragmented {} chunks ({} KB), {} face holes left",
+                      movedChunks, movedBytes / 1024, faceAllocator_.getEnd() - faceAllocator_.getUsed());
     }
-
-    indirectBuffer_.unmap();
-    chunkDataBuffer_.unmap();
-
-    // spdlog::debug("Rebuilt draw commands: {} chunks (face/lighting data unchanged)",
-    //              m_drawCommandCount);
 }
 
 bool ChunkBufferManager::hasAllocation(const ChunkPosition& pos) const {
@@ -1,8 +1,15 @@
 #pragma once
 
 #include "Buffer.hpp"
+#include "BufferUploader.hpp"
+#include "../sync/FrameSync.hpp"
 #include "../../world/ChunkManager.hpp"
 #include "../../world/ChunkGpuData.hpp"
+#include "../../world/ChunkCuller.hpp"
+#include "../../world/ChunkVisibilityGraph.hpp"
+#include "../../util/RangeAllocator.hpp"
+#include <array>
+#include <deque>
 #include <unordered_map>
 #include <vector>
 
@@ -12,31 +19,51 @@ struct ChunkBufferAllocation {
     uint32_t faceOffset;      // Offset in FaceData buffer
     uint32_t faceCount;       // Number of faces
     uint32_t lightingOffset;  // Offset in lighting buffer
-    uint32_t drawCommandIndex;
+    uint32_t lightingCount;   // Number of PackedLighting entries
+    uint32_t drawCommandIndex; // Metadata slot (stable while the chunk stays loaded)
+    glm::ivec3 boundsMin;     // Chunk-local mesh bounds (CompactChunkMesh::boundsMin/boundsMax)
+    glm::ivec3 boundsMax;
+    std::array<uint32_t, FACE_BUCKET_COUNT> bucketCounts;  // Faces per direction bucket, consecutive from faceOffset
 };
 
 class ChunkBufferManager {
 public:
-    void init(VmaAllocator allocator, size_t maxFaces, size_t maxDrawCommands);
+    void init(VulkanContext& context, size_t maxFaces, size_t maxDrawCommands);
     void cleanup();
     void clear();  // Clear all meshes and reset state
 
-    // Add new meshes incrementally (returns false if buffer is full)
-    bool addMeshes(std::vector<CompactChunkMesh>& meshes, size_t maxPerFrame);
+    // Call once per frame before any other update: recycles ranges the GPU can no longer be reading
+    void beginFrame();
+
+    // Upload meshes from the front of the list until byteBudget bytes are staged (at least one mesh)
+    // Returns how many meshes were consumed; a mesh that doesn't fit in the buffers is dropped
+    size_t addMeshes(std::vector<CompactChunkMesh>& meshes, size_t byteBudget);
 
     // Remove meshes for unloaded chunks
     void removeUnloadedChunks(const ChunkManager& chunkManager);
 
-    // Compact buffer when fragmented
-    void compactIfNeeded(const std::unordered_map<ChunkPosition, CompactChunkMesh, ChunkPositionHash>& meshCache);
+    // Move chunks from the top of the face/lighting buffers into lower holes, copying at most byteBudget bytes
+    void defragment(size_t byteBudget);
+
+    // Submit this frame's uploads, including frameSlot's copy of the chunk metadata (frameSlot = frame
+    // in flight, whose previous use has finished); the frame must wait for the returned value on getUploadSemaphore()
+    uint64_t flushUploads(uint32_t frameSlot);
+    VkSemaphore getUploadSemaphore() const { return uploader_.getTimelineSemaphore(); }
 
-    // Get current draw count for rendering
-    uint32_t getDrawCommandCount() const { return drawCommandCount_; }
+    // Cull chunks against the camera and write the visible draw commands, nearest first, into
+    // frameSlot's indirect buffer (frameSlot = frame in flight, whose previous use has finished)
+    // Chunks must also be reachable from the camera through the chunk connectivity graph
+    // Each visible chunk gets one draw per face bucket that can face the camera
+    void prepareDraws(const Frustum& frustum, const glm::vec3& cameraPos, float maxDistance, uint32_t frameSlot);
+
+    // Draws written by the last prepareDraws() (one per visible face bucket), and all chunks with geometry
+    uint32_t getDrawCommandCount() const { return visibleDrawCount_; }
+    uint32_t getTotalDrawCommandCount() const { return static_cast<uint32_t>(allocations_.size()); }
 
     // Get buffers for binding
     VkBuffer getFaceBuffer() const { return faceBuffer_.getBuffer(); }
     VkBuffer getLightingBuffer() const { return lightingBuffer_.getBuffer(); }
-    VkBuffer getIndirectBuffer() const { return indirectBuffer_.getBuffer(); }
+    VkBuffer getIndirectBuffer() const { return indirectBuffers_[indirectSlot_].getBuffer(); }
     VkBuffer getChunkDataBuffer() const { return chunkDataBuffer_.getBuffer(); }
 
     // Check if a chunk has an allocation
@@ -47,24 +74,69 @@ public:
     std::unordered_map<ChunkPosition, CompactChunkMesh, ChunkPositionHash>& getMeshCache() { return meshCache_; }
 
 private:
-    Buffer faceBuffer_;      // FaceData buffer (replaces vertex buffer)
-    Buffer lightingBuffer_;  // PackedLighting buffer (replaces index buffer)
-    Buffer indirectBuffer_;  // VkDrawIndirectCommand buffer
-    Buffer chunkDataBuffer_; // ChunkData buffer (per-chunk metadata, indexed by gl_BaseInstance)
+    Buffer faceBuffer_;      // FaceData buffer (replaces vertex buffer), device-local
+    Buffer lightingBuffer_;  // PackedLighting buffer (replaces index buffer), device-local
+    // VkDrawIndirectCommand buffers, host-visible, one per frame in flight (rewritten every frame)
+    // Room for every bucket of every chunk
+    std::array<Buffer, FrameSync::MAX_FRAMES_IN_FLIGHT> indirectBuffers_;
+    // ChunkData buffer (per-chunk metadata, indexed by gl_BaseInstance), device-local
+    // One maxDrawCommands_ copy per frame in flight: a frame's draws read only its own copy
+    Buffer chunkDataBuffer_;
+    BufferUploader uploader_;
 
     size_t maxFaces_;
     size_t maxDrawCommands_;
 
-    uint32_t currentFaceOffset_ = 0;
-    uint32_t currentLightingOffset_ = 0;
-    uint32_t drawCommandCount_ = 0;
+    // Ranges freed while frames in flight may still read them
+    struct RetiredRange {
+        uint64_t frame;  // frameIndex_ when retired
+        uint32_t offset;
+        uint32_t count;
+        bool lighting;   // Lighting allocator, else face allocator
+    };
+
+    RangeAllocator faceAllocator_;      // In faces
+    RangeAllocator lightingAllocator_;  // In PackedLighting entries
+    std::deque<RetiredRange> retiredRanges_;
+    uint64_t frameIndex_ = 0;
+    uint32_t slotCount_ = 0;               // Slots ever handed out (free ones included)
+    std::vector<uint32_t> freeSlots_;      // Released slots, reused before new ones
 
     std::unordered_map<ChunkPosition, CompactChunkMesh, ChunkPositionHash> meshCache_;
     std::unordered_map<ChunkPosition, ChunkBufferAllocation, ChunkPositionHash> allocations_;
-    std::vector<ChunkGpuMetadata> chunkDataArray_;  // CPU-side copy of chunk data (indexed by draw command)
-
-    void fullRebuild();
-    void rebuildDrawCommands();  // Fast rebuild: only updates draw commands, not face/lighting data
+    std::unordered_map<ChunkPosition, uint64_t, ChunkPositionHash> meshSequences_;  // Sequence of the last applied mesh
+    std::vector<ChunkGpuMetadata> chunkDataArray_;  // CPU-side copy of chunk data (indexed by slot)
+    // What prepareDraws() needs of each chunk beyond the culler's bounds
+    struct ChunkDraw {
+        glm::ivec3 boundsMin;  // World block bounds
+        glm::ivec3 boundsMax;
+        std::array<uint32_t, FACE_BUCKET_COUNT> bucketCounts;
+    };
+
+    std::vector<ChunkDraw> chunkDraws_;  // Every chunk with geometry (indexed by slot, free slots have no buckets)
+    ChunkCuller culler_;                 // World bounds (indexed by slot)
+    ChunkVisibilityGraph visibilityGraph_;  // Connectivity of every chunk in meshSequences_
+    std::vector<ChunkPosition> reachableChunks_;
+    std::vector<uint8_t> reachableSlots_;   // Per slot: reached by the last traversal
+    std::vector<uint32_t> visibleDraws_;
+    uint32_t visibleDrawCount_ = 0;
+    uint32_t indirectSlot_ = 0;
+    // Per frame in flight: slots of chunkDataArray_ changed since that copy was last uploaded (empty if begin >= end)
+    struct MetadataSpan {
+        uint32_t begin = UINT32_MAX;
+        uint32_t end = 0;
+    };
+    std::array<MetadataSpan, FrameSync::MAX_FRAMES_IN_FLIGHT> metadataDirty_;
+
+    void retire(bool lighting, uint32_t offset, uint32_t count);
+    void retireAllocation(const ChunkBufferAllocation& allocation);
+    // Allocate both ranges into allocation (offsets and counts); false, with nothing taken, if either is full
+    bool allocateRanges(uint32_t faceCount, uint32_t lightingCount, ChunkBufferAllocation& allocation);
+    void writeMeshData(const CompactChunkMesh& mesh, const ChunkBufferAllocation& allocation);
+    void writeDrawCommand(const ChunkPosition& pos, const ChunkBufferAllocation& allocation);
+    void resizeDrawCommands(size_t count);
+    uint32_t acquireSlot();  // Caller checks there is room (a free slot or slotCount_ < maxDrawCommands_)
+    void releaseSlot(uint32_t slot);
 };
 
 } // namespace FarHorizon
\ No newline at end of file
@@ -22,6 +22,10 @@ void StagingBuffer::cleanup() {
     m_stagingBuffer.cleanup();
 }
 
+void StagingBuffer::write(const void* data, VkDeviceSize size, VkDeviceSize offset) {
+    m_stagingBuffer.copyData(data, size, offset);
+}
+
 bool StagingBuffer::upload(
     CommandBuffer cmd,
     const void* data,
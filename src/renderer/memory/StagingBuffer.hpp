@@ -33,7 +33,11 @@ public:
         VkDeviceSize dstOffset = 0
     );
 
+    // Write data at an offset without recording a copy (for callers that batch their own copy regions)
+    void write(const void* data, VkDeviceSize size, VkDeviceSize offset);
+
     // Getters
+    VkBuffer getBuffer() const { return m_stagingBuffer.getBuffer(); }
     VkDeviceSize getSize() const { return m_stagingBuffer.getSize(); }
     bool isValid() const { return m_stagingBuffer.getBuffer() != VK_NULL_HANDLE; }
 
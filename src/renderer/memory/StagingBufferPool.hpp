@@ -1,7 +1,7 @@
 #pragma once
 
 #include "StagingBuffer.hpp"
-#include <vector>
+#include <deque>
 #include <memory>
 
 namespace FarHorizon {
@@ -42,7 +42,7 @@ private:
 
     VmaAllocator allocator_ = VK_NULL_HANDLE;
     VkDeviceSize defaultBufferSize_ = 0;
-    std::vector<PoolEntry> pool_;
+    std::deque<PoolEntry> pool_;  // deque: growing keeps handed-out pointers valid
 };
 
 } // namespace FarHorizon
\ No newline at end of file
@@ -31,6 +31,37 @@ void Semaphore::init(VkDevice device) {
     VK_CHECK(vkCreateSemaphore(m_device, &createInfo, nullptr, &m_semaphore));
 }
 
+void Semaphore::initTimeline(VkDevice device, uint64_t initialValue) {
+    m_device = device;
+
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = initialValue;
+
+    VkSemaphoreCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    createInfo.pNext = &typeInfo;
+
+    VK_CHECK(vkCreateSemaphore(m_device, &createInfo, nullptr, &m_semaphore));
+}
+
+uint64_t Semaphore::getCounterValue() const {
+    uint64_t value = 0;
+    VK_CHECK(vkGetSemaphoreCounterValue(m_device, m_semaphore, &value));
+    return value;
+}
+
+void Semaphore::wait(uint64_t value) const {
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &m_semaphore;
+    waitInfo.pValues = &value;
+
+    VK_CHECK(vkWaitSemaphores(m_device, &waitInfo, UINT64_MAX));
+}
+
 void Semaphore::cleanup() {
     if (m_device != VK_NULL_HANDLE && m_semaphore != VK_NULL_HANDLE) {
         vkDestroySemaphore(m_device, m_semaphore, nullptr);
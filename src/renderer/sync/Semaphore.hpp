@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vulkan/vulkan.h>
+#include <cstdint>
 
 namespace FarHorizon {
 
@@ -19,10 +20,16 @@ public:
     Semaphore& operator=(Semaphore&& other) noexcept;
 
     void init(VkDevice device);
+    // Timeline semaphore (Vulkan 1.2): a counter signalled/waited by value instead of a binary flag
+    void initTimeline(VkDevice device, uint64_t initialValue = 0);
     void cleanup();
 
     VkSemaphore getSemaphore() const { return m_semaphore; }
 
+    // Timeline semaphores only
+    uint64_t getCounterValue() const;
+    void wait(uint64_t value) const;
+
 private:
     VkDevice m_device = VK_NULL_HANDLE;
     VkSemaphore m_semaphore = VK_NULL_HANDLE;
@@ -0,0 +1,38 @@
+#include "Frustum.hpp"
+
+namespace FarHorizon {
+
+Frustum Frustum::fromMatrix(const glm::mat4& viewProjection) {
+    // glm is column-major: row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&](int i) {
+        return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    };
+    glm::vec4 x = row(0);
+    glm::vec4 y = row(1);
+    glm::vec4 z = row(2);
+    glm::vec4 w = row(3);
+
+    Frustum frustum;
+    frustum.planes_[Left] = w + x;
+    frustum.planes_[Right] = w - x;
+    frustum.planes_[Bottom] = w + y;
+    frustum.planes_[Top] = w - y;
+    frustum.planes_[Near] = w + z;
+    frustum.planes_[Far] = w - z;
+    return frustum;
+}
+
+bool Frustum::intersectsBox(const glm::vec3& min, const glm::vec3& max) const {
+    for (const glm::vec4& plane : planes_) {
+        // Corner furthest along the plane normal
+        glm::vec3 corner(plane.x >= 0.0f ? max.x : min.x,
+                         plane.y >= 0.0f ? max.y : min.y,
+                         plane.z >= 0.0f ? max.z : min.z);
+        if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace FarHorizon
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+
+namespace FarHorizon {
+
+// View frustum as six inward-facing planes (xyz = normal, w = distance): a point p is
+// inside a plane when dot(xyz, p) + w >= 0. Planes are not normalized.
+class Frustum {
+public:
+    enum Plane { Left, Right, Bottom, Top, Near, Far, PLANE_COUNT };
+
+    Frustum() = default;
+
+    // Extract planes from a (view-)projection matrix (Gribb/Hartmann)
+    // The near plane uses the -w..w depth convention, which is also conservative for 0..w
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+
+    const glm::vec4& getPlane(int plane) const { return planes_[plane]; }
+
+    // False only if the box lies entirely outside one of the planes (may keep boxes near corners)
+    bool intersectsBox(const glm::vec3& min, const glm::vec3& max) const;
+
+private:
+    std::array<glm::vec4, PLANE_COUNT> planes_{};
+};
+
+} // namespace FarHorizon
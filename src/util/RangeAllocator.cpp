@@ -0,0 +1,115 @@
+#include "RangeAllocator.hpp"
+#include <cassert>
+#include <iterator>
+
+namespace FarHorizon {
+
+void RangeAllocator::reset(uint32_t capacity) {
+    freeByOffset_.clear();
+    freeBySize_.clear();
+    capacity_ = capacity;
+    used_ = 0;
+    if (capacity > 0) {
+        insertFree(0, capacity);
+    }
+}
+
+void RangeAllocator::insertFree(uint32_t offset, uint32_t size) {
+    freeByOffset_.emplace(offset, size);
+    freeBySize_.emplace(size, offset);
+}
+
+void RangeAllocator::eraseFree(std::map<uint32_t, uint32_t>::iterator it) {
+    freeBySize_.erase({it->second, it->first});
+    freeByOffset_.erase(it);
+}
+
+uint32_t RangeAllocator::takeFrom(std::map<uint32_t, uint32_t>::iterator it, uint32_t size) {
+    uint32_t offset = it->first;
+    uint32_t remaining = it->second - size;
+    eraseFree(it);
+    if (remaining > 0) {
+        insertFree(offset + size, remaining);
+    }
+    used_ += size;
+    return offset;
+}
+
+uint32_t RangeAllocator::allocate(uint32_t size) {
+    if (size == 0) {
+        return 0;
+    }
+
+    auto fit = freeBySize_.lower_bound({size, 0});
+    if (fit == freeBySize_.end()) {
+        return INVALID_OFFSET;
+    }
+    return takeFrom(freeByOffset_.find(fit->second), size);
+}
+
+uint32_t RangeAllocator::allocateBelow(uint32_t size, uint32_t limit) {
+    if (size == 0) {
+        return 0;
+    }
+
+    for (auto it = freeByOffset_.begin(); it != freeByOffset_.end() && it->first + size <= limit; ++it) {
+        if (it->second >= size) {
+            return takeFrom(it, size);
+        }
+    }
+    return INVALID_OFFSET;
+}
+
+void RangeAllocator::free(uint32_t offset, uint32_t size) {
+    if (size == 0) {
+        return;
+    }
+    assert(offset + size <= capacity_ && size <= used_);
+    used_ -= size;
+
+    // Merge with the free range that ends where this one starts
+    auto next = freeByOffset_.lower_bound(offset);
+    if (next != freeByOffset_.begin()) {
+        auto prev = std::prev(next);
+        assert(prev->first + prev->second <= offset);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            eraseFree(prev);
+        }
+    }
+
+    // ...and with the one that starts where it ends
+    if (next != freeByOffset_.end()) {
+        assert(offset + size <= next->first);
+        if (offset + size == next->first) {
+            size += next->second;
+            eraseFree(next);
+        }
+    }
+
+    insertFree(offset, size);
+}
+
+bool RangeAllocator::tryGrow(uint32_t offset, uint32_t size, uint32_t newSize) {
+    if (newSize <= size) {
+        return newSize == size;
+    }
+
+    auto next = freeByOffset_.find(offset + size);
+    if (next == freeByOffset_.end() || next->second < newSize - size) {
+        return false;
+    }
+    takeFrom(next, newSize - size);
+    return true;
+}
+
+uint32_t RangeAllocator::getEnd() const {
+    if (freeByOffset_.empty()) {
+        return capacity_;
+    }
+    auto last = std::prev(freeByOffset_.end());
+    return last->first + last->second == capacity_ ? last->first : capacity_;
+}
+
+} // namespace FarHorizon
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace FarHorizon {
+
+// Sub-allocator for ranges of a fixed-capacity array (e.g. elements of a GPU buffer)
+// Free ranges are indexed by size for best-fit allocation and by offset so freed
+// neighbors coalesce immediately. Units are whatever the caller uses (elements, not bytes).
+// Headless (no Vulkan); not thread-safe, the owner serializes access
+class RangeAllocator {
+public:
+    static constexpr uint32_t INVALID_OFFSET = UINT32_MAX;
+
+    RangeAllocator() = default;
+    explicit RangeAllocator(uint32_t capacity) { reset(capacity); }
+
+    // Drop every allocation and make [0, capacity) one free range
+    void reset(uint32_t capacity);
+
+    // Best fit: smallest free range that holds size (lowest offset on ties)
+    // Returns INVALID_OFFSET if no free range is large enough. size 0 allocates nothing and returns 0
+    uint32_t allocate(uint32_t size);
+
+    // Lowest-offset free range that holds size and ends at or before limit (for compaction)
+    uint32_t allocateBelow(uint32_t size, uint32_t limit);
+
+    // Return a range; it merges with adjacent free ranges
+    void free(uint32_t offset, uint32_t size);
+
+    // Extend an allocation in place if the range right after it is free
+    bool tryGrow(uint32_t offset, uint32_t size, uint32_t newSize);
+
+    // Getters
+    uint32_t getCapacity() const { return capacity_; }
+    uint32_t getUsed() const { return used_; }
+    uint32_t getFree() const { return capacity_ - used_; }
+    uint32_t getLargestFreeRange() const { return freeBySize_.empty() ? 0 : freeBySize_.rbegin()->first; }
+    size_t getFreeRangeCount() const { return freeByOffset_.size(); }
+
+    // One past the highest allocated element (free space above it is contiguous)
+    uint32_t getEnd() const;
+
+private:
+    std::map<uint32_t, uint32_t> freeByOffset_;            // offset -> size
+    std::set<std::pair<uint32_t, uint32_t>> freeBySize_;   // (size, offset)
+    uint32_t capacity_ = 0;
+    uint32_t used_ = 0;
+
+    void insertFree(uint32_t offset, uint32_t size);
+    void eraseFree(std::map<uint32_t, uint32_t>::iterator it);
+    // Take size elements from the start of a free range
+    uint32_t takeFrom(std::map<uint32_t, uint32_t>::iterator it, uint32_t size);
+};
+
+} // namespace FarHorizon
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "BlockModel.hpp"
+#include "FaceDirection.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace FarHorizon {
+
+/**
+ * One pre-rotated model face, ready to be emitted by the mesher.
+ * Everything here is independent of the block's position in the world.
+ */
+struct BakedQuad {
+    uint16_t quadIndex = 0;                      // Index into the QuadInfo library
+    FaceDirection face = FaceDirection::UP;      // Face direction after variant rotation
+    FaceDirection cullface = FaceDirection::UP;  // Rotated cullface (only valid if hasCullface)
+    bool hasCullface = false;                    // Has a cullface AND the element reaches that block boundary
+    bool tinted = false;                         // Uses biome tint (tintindex set)
+    bool greedyMergeable = false;                // Full block face with one full texture tile
+    uint8_t bucket = 0;                          // Mesh face bucket (FaceUtils::toIndex or FACE_BUCKET_UNALIGNED)
+    uint8_t cornerSides[4] = {};                 // Per corner: bit 0 = on the +u side, bit 1 = on the +v side (greedy axes)
+};
+
+// Mesher fast path selected per blockstate
+enum class BakedModelType : uint8_t {
+    EMPTY,          // Invisible or no model - skipped
+    FULL_CUBE,      // Single 0-16 element, every face culled against its own direction
+    MULTI_ELEMENT   // Anything else (slabs, stairs, overlays, ...)
+};
+
+/**
+ * Flattened model for one blockstate, baked once after textures are registered.
+ * Turns meshing into table lookups plus culling tests.
+ */
+struct BakedBlockModel {
+    BakedModelType type = BakedModelType::EMPTY;
+    const BlockModel* model = nullptr;  // Source model (for BlockShape lookups during culling)
+    std::vector<BakedQuad> quads;
+    bool lodDrawable = false;  // Full-cube occluder with full mergeable faces on all six sides (LOD cell stand-in)
+};
+
+} // namespace FarHorizon
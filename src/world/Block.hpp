@@ -114,6 +114,21 @@ public:
         return currentState;  // Default: no change
     }
 
+    // Light emitted by this state (0-15, see LightEngine)
+    virtual uint8_t getLightEmission(BlockState state) const {
+        return 0;
+    }
+
+    // Whether light stops at this state. Default: every face is opaque (stone yes, glass/slabs/stairs no)
+    virtual bool blocksLight(BlockState state) const {
+        for (Face face : {Face::DOWN, Face::UP, Face::NORTH, Face::SOUTH, Face::WEST, Face::EAST}) {
+            if (!isFaceOpaque(state, face)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     // Check if a face should be invisible when adjacent to another block
     // Override in transparent blocks (glass, water, etc.) to implement special culling
     //
@@ -67,12 +67,20 @@ struct ChunkPosition {
     }
 };
 
+// Well-mixed 3D position hash: each axis is scaled by a distinct odd 64-bit constant,
+// then the splitmix64 finalizer spreads nearby positions over all bits
+// (std::hash<int32_t> is the identity on common standard libraries, which clusters badly)
 struct ChunkPositionHash {
     std::size_t operator()(const ChunkPosition& pos) const {
-        std::size_t h1 = std::hash<int32_t>{}(pos.x);
-        std::size_t h2 = std::hash<int32_t>{}(pos.y);
-        std::size_t h3 = std::hash<int32_t>{}(pos.z);
-        return h1 ^ (h2 << 1) ^ (h3 << 2);
+        uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(pos.x)) * 0x9E3779B97F4A7C15ull
+                   ^ static_cast<uint64_t>(static_cast<uint32_t>(pos.y)) * 0xC2B2AE3D27D4EB4Full
+                   ^ static_cast<uint64_t>(static_cast<uint32_t>(pos.z)) * 0x165667B19E3779F9ull;
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 27;
+        h *= 0x94D049BB133111EBull;
+        h ^= h >> 31;
+        return static_cast<std::size_t>(h);
     }
 };
 
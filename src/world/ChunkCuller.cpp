@@ -0,0 +1,150 @@
+#include "ChunkCuller.hpp"
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FARHORIZON_CULLER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace FarHorizon {
+
+static constexpr size_t LANES = 4;
+
+// Same integer/fraction split as the shader's camera-relative transform
+static void splitCamera(const glm::vec3& cameraPos, glm::ivec3& cameraInt, glm::vec3& cameraFrac) {
+    glm::vec3 cameraFloor = glm::floor(cameraPos);
+    cameraInt = glm::ivec3(cameraFloor);
+    cameraFrac = cameraPos - cameraFloor;
+}
+
+void ChunkCuller::resize(size_t count) {
+    count_ = count;
+    size_t padded = (count + LANES - 1) / LANES * LANES;
+    for (auto* axis : {&minX_, &minY_, &minZ_, &maxX_, &maxY_, &maxZ_}) {
+        axis->resize(padded, 0);
+    }
+}
+
+void ChunkCuller::setBounds(size_t slot, const glm::ivec3& min, const glm::ivec3& max) {
+    minX_[slot] = min.x;
+    minY_[slot] = min.y;
+    minZ_[slot] = min.z;
+    maxX_[slot] = max.x;
+    maxY_[slot] = max.y;
+    maxZ_[slot] = max.z;
+}
+
+void ChunkCuller::cull(const Frustum& frustum, const glm::vec3& cameraPos, float maxDistance,
+                       std::vector<uint32_t>& visible) {
+    ZoneScoped;
+#ifdef FARHORIZON_CULLER_SSE2
+    collectSse2(frustum, cameraPos, maxDistance);
+#else
+    collectScalar(frustum, cameraPos, maxDistance);
+#endif
+    emitSorted(visible);
+}
+
+void ChunkCuller::cullScalar(const Frustum& frustum, const glm::vec3& cameraPos, float maxDistance,
+                             std::vector<uint32_t>& visible) {
+    ZoneScoped;
+    collectScalar(frustum, cameraPos, maxDistance);
+    emitSorted(visible);
+}
+
+void ChunkCuller::collectScalar(const Frustum& frustum, const glm::vec3& cameraPos, float maxDistance) {
+    sorted_.clear();
+    glm::ivec3 cameraInt;
+    glm::vec3 cameraFrac;
+    splitCamera(cameraPos, cameraInt, cameraFrac);
+    float maxDistanceSq = maxDistance * maxDistance;
+
+    for (size_t i = 0; i < count_; i++) {
+        glm::vec3 min = glm::vec3(glm::ivec3(minX_[i], minY_[i], minZ_[i]) - cameraInt) - cameraFrac;
+        glm::vec3 max = glm::vec3(glm::ivec3(maxX_[i], maxY_[i], maxZ_[i]) - cameraInt) - cameraFrac;
+
+        glm::vec3 d = glm::max(glm::max(min, -max), glm::vec3(0.0f));
+        float distSq = glm::dot(d, d);
+        if (distSq <= maxDistanceSq && frustum.intersectsBox(min, max)) {
+            sorted_.emplace_back(distSq, static_cast<uint32_t>(i));
+        }
+    }
+}
+
+#ifdef FARHORIZON_CULLER_SSE2
+void ChunkCuller::collectSse2(const Frustum& frustum, const glm::vec3& cameraPos, float maxDistance) {
+    sorted_.clear();
+    glm::ivec3 cameraInt;
+    glm::vec3 cameraFrac;
+    splitCamera(cameraPos, cameraInt, cameraFrac);
+    float maxDistanceSq = maxDistance * maxDistance;
+
+    const __m128i camIntX = _mm_set1_epi32(cameraInt.x);
+    const __m128i camIntY = _mm_set1_epi32(cameraInt.y);
+    const __m128i camIntZ = _mm_set1_epi32(cameraInt.z);
+    const __m128 camFracX = _mm_set1_ps(cameraFrac.x);
+    const __m128 camFracY = _mm_set1_ps(cameraFrac.y);
+    const __m128 camFracZ = _mm_set1_ps(cameraFrac.z);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 maxDistSq = _mm_set1_ps(maxDistanceSq);
+
+    auto relative = [](const int32_t* values, size_t i, __m128i camInt, __m128 camFrac) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        return _mm_sub_ps(_mm_cvtepi32_ps(_mm_sub_epi32(v, camInt)), camFrac);
+    };
+
+    for (size_t i = 0; i < count_; i += LANES) {
+        __m128 minX = relative(minX_.data(), i, camIntX, camFracX);
+        __m128 minY = relative(minY_.data(), i, camIntY, camFracY);
+        __m128 minZ = relative(minZ_.data(), i, camIntZ, camFracZ);
+        __m128 maxX = relative(maxX_.data(), i, camIntX, camFracX);
+        __m128 maxY = relative(maxY_.data(), i, camIntY, camFracY);
+        __m128 maxZ = relative(maxZ_.data(), i, camIntZ, camFracZ);
+
+        // Distance from the camera to the nearest point of each box (0 inside)
+        __m128 dx = _mm_max_ps(_mm_max_ps(minX, _mm_sub_ps(zero, maxX)), zero);
+        __m128 dy = _mm_max_ps(_mm_max_ps(minY, _mm_sub_ps(zero, maxY)), zero);
+        __m128 dz = _mm_max_ps(_mm_max_ps(minZ, _mm_sub_ps(zero, maxZ)), zero);
+        __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        __m128 inside = _mm_cmple_ps(distSq, maxDistSq);
+
+        // Outside a plane when even the corner furthest along its normal is behind it
+        for (int p = 0; p < Frustum::PLANE_COUNT; p++) {
+            const glm::vec4& plane = frustum.getPlane(p);
+            __m128 x = plane.x >= 0.0f ? maxX : minX;
+            __m128 y = plane.y >= 0.0f ? maxY : minY;
+            __m128 z = plane.z >= 0.0f ? maxZ : minZ;
+            __m128 dot = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_mul_ps(y, _mm_set1_ps(plane.y))),
+                _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(dot, zero));
+        }
+
+        int mask = _mm_movemask_ps(inside);
+        if (mask == 0) {
+            continue;
+        }
+
+        alignas(16) float distances[LANES];
+        _mm_store_ps(distances, distSq);
+        for (size_t lane = 0; lane < LANES && i + lane < count_; lane++) {
+            if (mask & (1 << lane)) {
+                sorted_.emplace_back(distances[lane], static_cast<uint32_t>(i + lane));
+            }
+        }
+    }
+}
+#endif
+
+void ChunkCuller::emitSorted(std::vector<uint32_t>& visible) {
+    visible.clear();
+    std::sort(sorted_.begin(), sorted_.end());
+    visible.reserve(sorted_.size());
+    for (const auto& [distSq, slot] : sorted_) {
+        visible.push_back(slot);
+    }
+}
+
+} // namespace FarHorizon
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../util/Frustum.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace FarHorizon {
+
+/**
+ * CPU frustum and distance culling of chunk draws, independent of Vulkan.
+ *
+ * Bounds live in slots (ChunkBufferManager uses its draw command index) stored as
+ * a structure of arrays in integer world block coordinates, so they stay exact far
+ * from the origin. cull() moves them into camera-relative floats and tests four
+ * boxes per step with SSE2 (scalar fallback on other targets).
+ *
+ * Not thread-safe (owned by the render thread).
+ */
+class ChunkCuller {
+public:
+    ChunkCuller() = default;
+
+    /**
+     * Set the number of slots. New slots hold an empty box at the origin until setBounds().
+     */
+    void resize(size_t count);
+    void clear() { resize(0); }
+    size_t size() const { return count_; }
+
+    /**
+     * World-space block bounds of a slot (max is exclusive, i.e. the far corner of the last block).
+     */
+    void setBounds(size_t slot, const glm::ivec3& min, const glm::ivec3& max);
+
+    /**
+     * Collect the slots whose box intersects the frustum and lies within maxDistance
+     * of the camera, nearest first (front-to-back for early depth rejection).
+     * @param frustum Camera-relative planes (Camera::getFrustum)
+     */
+    void cull(const Frustum& frustum, const glm::vec3& cameraPos, float maxDistance,
+              std::vector<uint32_t>& visible);
+
+    /**
+     * cull() on the scalar path, which other targets fall back to. Same results;
+     * kept callable so the SIMD path can be checked against it.
+     */
+    void cullScalar(const Frustum& frustum, const glm::vec3& cameraPos, float maxDistance,
+                    std::vector<uint32_t>& visible);
+
+private:
+    // Padded to a multiple of 4 so the SIMD loop never reads past the end
+    std::vector<int32_t> minX_, minY_, minZ_;
+    std::vector<int32_t> maxX_, maxY_, maxZ_;
+    size_t count_ = 0;
+
+    std::vector<std::pair<float, uint32_t>> sorted_;  // (distance², slot), reused between frames
+
+    // Fill sorted_ with the slots that pass (unordered)
+    void collectScalar(const Frustum& frustum, const glm::vec3& cameraPos, float maxDistance);
+    void collectSse2(const Frustum& frustum, const glm::vec3& cameraPos, float maxDistance);
+    // Sort sorted_ nearest first into visible
+    void emitSorted(std::vector<uint32_t>& visible);
+};
+
+} // namespace FarHorizon
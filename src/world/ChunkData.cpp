@@ -1,79 +1,248 @@
 #include "ChunkData.hpp"
+#include "TerrainColumnCache.hpp"
 #include "BlockRegistry.hpp"
 #include "blocks/SlabBlock.hpp"
-#include <FastNoise/FastNoise.h>
 #include <tracy/Tracy.hpp>
+#include <cstring>
 
 namespace FarHorizon {
 
-// Static noise generator for terrain
-static FastNoise::SmartNode<> getTerrainNoise() {
-    static auto noise = FastNoise::New<FastNoise::OpenSimplex2>();
-    return noise;
-}
-
 ChunkData::ChunkData(const ChunkPosition& position)
     : position_(position)
     , palette_()
-    , data_{}
-    , empty_(true)
+    , storage_()
+    , nonAirCount_(0)
     , version_(0) {
 }
 
 ChunkData::ChunkData(const ChunkPosition& position,
                      ChunkPalette palette,
-                     std::array<uint8_t, CHUNK_VOLUME> data,
-                     bool empty,
+                     PackedBlockStorage storage,
+                     uint32_t nonAirCount,
                      uint32_t version)
     : position_(position)
     , palette_(std::move(palette))
-    , data_(std::move(data))
-    , empty_(empty)
+    , storage_(std::move(storage))
+    , nonAirCount_(nonAirCount)
     , version_(version) {
 }
 
 BlockState ChunkData::getBlockState(uint32_t x, uint32_t y, uint32_t z) const {
     uint32_t index = getBlockIndex(x, y, z);
-    uint8_t paletteIndex = data_[index];
+    uint16_t paletteIndex = storage_.get(index);
     return BlockState(palette_.getStateId(paletteIndex));
 }
 
+size_t ChunkData::getMemoryUsage() const {
+    // Palette: state list plus the sorted lookup entries
+    return sizeof(ChunkData) + storage_.getMemoryUsage() + palette_.size() * (sizeof(uint16_t) + sizeof(uint32_t));
+}
+
 std::shared_ptr<const ChunkData> ChunkData::withBlockState(
     uint32_t x, uint32_t y, uint32_t z, BlockState state) const {
+    return withBlockStates({{static_cast<uint16_t>(getBlockIndex(x, y, z)), state}});
+}
+
+std::shared_ptr<const ChunkData> ChunkData::withBlockStates(const std::vector<BlockEdit>& edits) const {
     ZoneScoped;
 
-    // Copy palette and data
+    // Copy palette and packed indices once for the whole batch
     ChunkPalette newPalette = palette_;
-    std::array<uint8_t, CHUNK_VOLUME> newData = data_;
+    PackedBlockStorage newStorage = storage_;
+    uint32_t nonAirCount = nonAirCount_;
 
-    // Add new state to palette and update data
-    uint8_t paletteIndex = newPalette.getOrAddIndex(state.id);
-    uint32_t blockIndex = getBlockIndex(x, y, z);
-    newData[blockIndex] = paletteIndex;
+    for (const auto& edit : edits) {
+        BlockState oldState(newPalette.getStateId(newStorage.get(edit.index)));
+        if (oldState == edit.state) {
+            continue;
+        }
 
-    // Determine if chunk is now empty
-    bool newEmpty = true;
-    BlockState airState = BlockRegistry::AIR->getDefaultState();
-    for (uint32_t i = 0; i < CHUNK_VOLUME; i++) {
-        if (newPalette.getStateId(newData[i]) != airState.id) {
-            newEmpty = false;
-            break;
+        // Add new state to palette, widening the storage if the palette outgrew it
+        uint16_t paletteIndex = newPalette.getOrAddIndex(edit.state.id);
+        newStorage.ensureCapacity(newPalette.size());
+        newStorage.set(edit.index, paletteIndex);
+
+        // Running count instead of rescanning all blocks for emptiness
+        if (oldState.isAir() && !edit.state.isAir()) {
+            nonAirCount++;
+        } else if (!oldState.isAir() && edit.state.isAir()) {
+            nonAirCount--;
         }
     }
 
     return std::make_shared<const ChunkData>(
         position_,
         std::move(newPalette),
-        std::move(newData),
-        newEmpty,
+        std::move(newStorage),
+        nonAirCount,
         version_ + 1  // Increment version for mesh invalidation
     );
 }
 
-std::shared_ptr<const ChunkData> ChunkData::generate(const ChunkPosition& position) {
+std::shared_ptr<const ChunkData> ChunkData::fromStateIds(
+    const ChunkPosition& position, const uint16_t* stateIds, uint32_t version) {
     ZoneScoped;
 
-    static auto noise = getTerrainNoise();
+    // Palette in first-seen order, containing only states that are present
+    ChunkPalette palette(std::vector<uint16_t>{stateIds[0]});
+    std::array<uint16_t, CHUNK_VOLUME> indices;
+    uint16_t lastState = stateIds[0];
+    uint16_t lastIndex = 0;
+    uint32_t nonAirCount = 0;
+
+    for (uint32_t i = 0; i < CHUNK_VOLUME; i++) {
+        uint16_t stateId = stateIds[i];
+        if (stateId != lastState) {
+            lastState = stateId;
+            lastIndex = palette.getOrAddIndex(stateId);
+        }
+        indices[i] = lastIndex;
+        if (!BlockState(stateId).isAir()) {
+            nonAirCount++;
+        }
+    }
+
+    PackedBlockStorage storage(palette.size());
+    if (storage.getBitsPerEntry() != 0) {
+        for (uint32_t i = 0; i < CHUNK_VOLUME; i++) {
+            storage.set(i, indices[i]);
+        }
+    }
+
+    return std::make_shared<const ChunkData>(
+        position,
+        std::move(palette),
+        std::move(storage),
+        nonAirCount,
+        version
+    );
+}
+
+// Bumped whenever the layout written by serialize() changes
+static constexpr uint8_t CHUNK_FORMAT_VERSION = 1;
+
+template<typename T>
+static void appendValue(std::vector<uint8_t>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+static bool readValue(const uint8_t*& cursor, const uint8_t* end, T& value) {
+    if (static_cast<size_t>(end - cursor) < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+std::vector<uint8_t> ChunkData::serialize() const {
+    ZoneScoped;
+
+    // Layout: format, palette count, palette IDs, bits per entry, packed words
+    const auto& states = palette_.getStates();
+    const auto& words = storage_.getWords();
+
+    std::vector<uint8_t> out;
+    out.reserve(4 + states.size() * sizeof(uint16_t) + words.size() * sizeof(uint64_t));
+    appendValue(out, CHUNK_FORMAT_VERSION);
+    appendValue(out, static_cast<uint16_t>(states.size()));
+    for (uint16_t stateId : states) {
+        appendValue(out, stateId);
+    }
+    appendValue(out, storage_.getBitsPerEntry());
+    for (uint64_t word : words) {
+        appendValue(out, word);
+    }
+    return out;
+}
+
+std::shared_ptr<const ChunkData> ChunkData::deserialize(
+    const ChunkPosition& position, const uint8_t* data, size_t size) {
+    ZoneScoped;
+
+    const uint8_t* cursor = data;
+    const uint8_t* end = data + size;
+
+    uint8_t format = 0;
+    uint16_t paletteSize = 0;
+    if (!readValue(cursor, end, format) || format != CHUNK_FORMAT_VERSION ||
+        !readValue(cursor, end, paletteSize) || paletteSize == 0) {
+        return nullptr;
+    }
+
+    std::vector<uint16_t> states(paletteSize);
+    for (auto& stateId : states) {
+        if (!readValue(cursor, end, stateId)) {
+            return nullptr;
+        }
+    }
+
+    uint8_t bitsPerEntry = 0;
+    if (!readValue(cursor, end, bitsPerEntry) || bitsPerEntry > 16 ||
+        bitsPerEntry < PackedBlockStorage::getBitsForPaletteSize(paletteSize) ||
+        (bitsPerEntry != 0 && PackedBlockStorage::getBitsForPaletteSize(size_t{1} << bitsPerEntry) != bitsPerEntry)) {
+        return nullptr;
+    }
+
+    std::vector<uint64_t> words(PackedBlockStorage::getWordCount(bitsPerEntry));
+    for (auto& word : words) {
+        if (!readValue(cursor, end, word)) {
+            return nullptr;
+        }
+    }
+
+    PackedBlockStorage storage(bitsPerEntry, std::move(words));
+    uint32_t nonAirCount = 0;
+    for (uint32_t i = 0; i < CHUNK_VOLUME; i++) {
+        uint16_t paletteIndex = storage.get(i);
+        if (paletteIndex >= paletteSize) {
+            return nullptr;
+        }
+        if (!BlockState(states[paletteIndex]).isAir()) {
+            nonAirCount++;
+        }
+    }
+
+    return std::make_shared<const ChunkData>(
+        position,
+        ChunkPalette(std::move(states)),
+        std::move(storage),
+        nonAirCount,
+        0
+    );
+}
+
+// Stone slab sphere shell: blocks whose distance to the center lies in [inner, outer]
+static const glm::vec3 SLAB_SPHERE_CENTER(0.0f, 50.0f, 0.0f);
+static constexpr float SLAB_SPHERE_INNER = 20.0f;
+static constexpr float SLAB_SPHERE_OUTER = 30.0f;
+
+// Conservative test: can any block position in the chunk fall inside the sphere shell?
+static bool chunkTouchesSlabSphere(const glm::vec3& chunkWorldPos) {
+    glm::vec3 chunkMax = chunkWorldPos + glm::vec3(static_cast<float>(CHUNK_SIZE - 1));
+    glm::vec3 nearest = glm::clamp(SLAB_SPHERE_CENTER, chunkWorldPos, chunkMax);
+    glm::vec3 farthest = glm::max(glm::abs(chunkWorldPos - SLAB_SPHERE_CENTER), glm::abs(chunkMax - SLAB_SPHERE_CENTER));
+    return glm::length(nearest - SLAB_SPHERE_CENTER) <= SLAB_SPHERE_OUTER &&
+           glm::length(farthest) >= SLAB_SPHERE_INNER;
+}
+
+std::shared_ptr<const ChunkData> ChunkData::uniform(const ChunkPosition& position, BlockState state) {
+    if (state.isAir()) {
+        return std::make_shared<const ChunkData>(position);
+    }
+    return std::make_shared<const ChunkData>(
+        position,
+        ChunkPalette(std::vector<uint16_t>{state.id}),
+        PackedBlockStorage(1),
+        CHUNK_VOLUME,
+        0  // Initial version
+    );
+}
+
+std::shared_ptr<const ChunkData> ChunkData::generate(const ChunkPosition& position, TerrainColumnCache* columns) {
+    ZoneScoped;
 
     glm::vec3 chunkWorldPos(
         position.x * static_cast<int32_t>(CHUNK_SIZE),
@@ -81,41 +250,37 @@ std::shared_ptr<const ChunkData> ChunkData::generate(const ChunkPosition& positi
         position.z * static_cast<int32_t>(CHUNK_SIZE)
     );
 
-    // Batch generate noise for the entire chunk's X/Z plane (SIMD optimized)
-    std::vector<float> noiseOutput(CHUNK_SIZE * CHUNK_SIZE);
-    constexpr float frequency = 0.02f;
-    noise->GenUniformGrid2D(
-        noiseOutput.data(),
-        static_cast<int>(chunkWorldPos.x),
-        static_cast<int>(chunkWorldPos.z),
-        CHUNK_SIZE, CHUNK_SIZE,
-        frequency, 1337
-    );
+    // Heightmap is shared by the whole column; without a cache compute it for this chunk only
+    TerrainColumnPtr column = columns
+        ? columns->getColumn(position.x, position.z)
+        : std::make_shared<const TerrainColumn>(TerrainColumn::compute(position.x, position.z));
 
-    // Pre-compute terrain heights from noise
-    int terrainHeights[CHUNK_SIZE][CHUNK_SIZE];
-    for (uint32_t x = 0; x < CHUNK_SIZE; x++) {
-        for (uint32_t z = 0; z < CHUNK_SIZE; z++) {
-            float noiseValue = noiseOutput[x + z * CHUNK_SIZE];
-            terrainHeights[x][z] = static_cast<int>((noiseValue + 1.0f) * 32.0f);
+    // Classify from the column bounds before touching any voxel
+    int32_t chunkBottom = position.y * static_cast<int32_t>(CHUNK_SIZE);
+    int32_t chunkTop = chunkBottom + static_cast<int32_t>(CHUNK_SIZE) - 1;
+    bool hasSlabSphere = chunkTouchesSlabSphere(chunkWorldPos);
+    if (!hasSlabSphere) {
+        if (chunkBottom > column->maxHeight) {
+            return uniform(position, BlockState(BlockRegistry::AIR->getDefaultState().id));
+        }
+        if (chunkTop < column->minHeight) {
+            return uniform(position, BlockState(BlockRegistry::STONE->getDefaultState().id));
         }
     }
 
-    ChunkPalette palette;
-    std::array<uint8_t, CHUNK_VOLUME> data{};
-    bool hasBlocks = false;
+    std::array<uint16_t, CHUNK_VOLUME> states;
 
-    // Get palette indices for common blocks
-    uint8_t airIndex = palette.getOrAddIndex(BlockRegistry::AIR->getDefaultState().id);
-    uint8_t stoneIndex = palette.getOrAddIndex(BlockRegistry::STONE->getDefaultState().id);
-    uint8_t grassIndex = palette.getOrAddIndex(BlockRegistry::GRASS_BLOCK->getDefaultState().id);
+    // State IDs for common blocks
+    uint16_t airState = BlockRegistry::AIR->getDefaultState().id;
+    uint16_t stoneState = BlockRegistry::STONE->getDefaultState().id;
+    uint16_t grassState = BlockRegistry::GRASS_BLOCK->getDefaultState().id;
 
     // Fill with air initially
-    data.fill(airIndex);
+    states.fill(airState);
 
     for (uint32_t x = 0; x < CHUNK_SIZE; x++) {
         for (uint32_t z = 0; z < CHUNK_SIZE; z++) {
-            int terrainHeight = terrainHeights[x][z];
+            int terrainHeight = column->getHeight(x, z);
 
             for (uint32_t y = 0; y < CHUNK_SIZE; y++) {
                 glm::vec3 worldPos = chunkWorldPos + glm::vec3(x, y, z);
@@ -124,18 +289,19 @@ std::shared_ptr<const ChunkData> ChunkData::generate(const ChunkPosition& positi
                 // OpenSimplex2 terrain generation
                 if (worldPos.y <= terrainHeight) {
                     if (worldPos.y == terrainHeight) {
-                        data[blockIndex] = grassIndex;
+                        states[blockIndex] = grassState;
                     } else {
-                        data[blockIndex] = stoneIndex;
+                        states[blockIndex] = stoneState;
                     }
-                    hasBlocks = true;
                 }
 
                 // Stone slab sphere
-                glm::vec3 center(0.0f, 50.0f, 0.0f);
-                float distance = glm::length(worldPos - center);
+                if (!hasSlabSphere) {
+                    continue;
+                }
+                float distance = glm::length(worldPos - SLAB_SPHERE_CENTER);
 
-                if (distance >= 20.0f && distance <= 30.0f) {
+                if (distance >= SLAB_SPHERE_INNER && distance <= SLAB_SPHERE_OUTER) {
                     SlabBlock* slabBlock = static_cast<SlabBlock*>(BlockRegistry::STONE_SLAB);
                     BlockState slabState;
                     if (static_cast<int>(worldPos.y) % 2 == 1) {
@@ -143,21 +309,13 @@ std::shared_ptr<const ChunkData> ChunkData::generate(const ChunkPosition& positi
                     } else {
                         slabState = slabBlock->withType(SlabType::BOTTOM);
                     }
-                    uint8_t slabIndex = palette.getOrAddIndex(slabState.id);
-                    data[blockIndex] = slabIndex;
-                    hasBlocks = true;
+                    states[blockIndex] = slabState.id;
                 }
             }
         }
     }
 
-    return std::make_shared<const ChunkData>(
-        position,
-        std::move(palette),
-        std::move(data),
-        !hasBlocks,
-        0  // Initial version
-    );
+    return fromStateIds(position, states.data(), 0);  // Initial version
 }
 
 } // namespace FarHorizon
\ No newline at end of file
@@ -2,23 +2,35 @@
 
 #include "BlockState.hpp"
 #include "ChunkPalette.hpp"
+#include "PackedBlockStorage.hpp"
 #include "Chunk.hpp"
 #include <glm/glm.hpp>
 #include <array>
 #include <memory>
 #include <atomic>
+#include <vector>
 
 namespace FarHorizon {
 
+class TerrainColumnCache;
+
+/**
+ * One block change inside a chunk.
+ */
+struct BlockEdit {
+    uint16_t index;    // Local block index (see ChunkData::getBlockIndex)
+    BlockState state;
+};
+
 /**
  * Immutable chunk data - thread-safe for concurrent reads.
  *
- * Once created, ChunkData is NEVER modified. This enables:
+ * Once created, ChunkData's blocks are NEVER modified (only the atomic mesh dirty flag and mesh LOD level change). This enables:
  * - Lock-free reads from multiple mesh workers
  * - Safe concurrent access without synchronization
  * - Automatic cleanup via shared_ptr reference counting
  *
- * For edits, use withBlockState() to create a new ChunkData with the modification.
+ * For edits, use withBlockState() / withBlockStates() to create a new ChunkData with the modification.
  */
 class ChunkData {
 public:
@@ -28,17 +40,37 @@ public:
     // Create from existing data (used by generate() and withBlockState())
     ChunkData(const ChunkPosition& position,
               ChunkPalette palette,
-              std::array<uint8_t, CHUNK_VOLUME> data,
-              bool empty,
+              PackedBlockStorage storage,
+              uint32_t nonAirCount,
               uint32_t version);
 
     // Accessors - all const, thread-safe
     const ChunkPosition& getPosition() const { return position_; }
     BlockState getBlockState(uint32_t x, uint32_t y, uint32_t z) const;
-    bool isEmpty() const { return empty_; }
+    bool isEmpty() const { return nonAirCount_ == 0; }
+    uint32_t getNonAirCount() const { return nonAirCount_; }
     uint32_t getVersion() const { return version_; }
+
+    // Mesh dirty flag (lock-free, new chunks start dirty). Marks made while a mesh
+    // is being built stay set, so they coalesce into one follow-up job.
+    // Returns true if the flag was clear (the chunk had been meshed since the last mark)
+    bool markMeshDirty() const { return !meshDirty_.exchange(true, std::memory_order_acq_rel); }
+    bool isMeshDirty() const { return meshDirty_.load(std::memory_order_acquire); }
+    // Clear the flag before snapshotting for a mesh; returns whether it was set
+    bool takeMeshDirty() const { return meshDirty_.exchange(false, std::memory_order_acq_rel); }
+    // Level of detail the chunk was last meshed at (0 = full resolution, see ChunkManager::setLodRadii)
+    uint8_t getMeshLod() const { return meshLod_.load(std::memory_order_relaxed); }
+    void setMeshLod(uint8_t level) const { meshLod_.store(level, std::memory_order_relaxed); }
     const ChunkPalette& getPalette() const { return palette_; }
-    const uint8_t* getData() const { return data_.data(); }
+    const PackedBlockStorage& getStorage() const { return storage_; }
+
+    // Approximate resident bytes (object + palette + packed indices)
+    size_t getMemoryUsage() const;
+
+    // Local block index: x + y*16 + z*256
+    static uint32_t getBlockIndex(uint32_t x, uint32_t y, uint32_t z) {
+        return x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE;
+    }
 
     /**
      * Create a NEW ChunkData with one block changed (copy-on-write).
@@ -49,22 +81,53 @@ public:
     std::shared_ptr<const ChunkData> withBlockState(
         uint32_t x, uint32_t y, uint32_t z, BlockState state) const;
 
+    /**
+     * Create a NEW ChunkData with many blocks changed, copying the palette and
+     * storage once. Edits are applied in order (a later edit to the same block wins).
+     *
+     * @return New ChunkData with the modifications, incremented version
+     */
+    std::shared_ptr<const ChunkData> withBlockStates(const std::vector<BlockEdit>& edits) const;
+
     /**
      * Generate terrain and return new immutable ChunkData.
      * This is a static factory method.
+     *
+     * Heights come from the column cache when given. Chunks entirely above or
+     * below the column's height range are emitted as uniform without a voxel pass.
+     */
+    static std::shared_ptr<const ChunkData> generate(const ChunkPosition& position,
+                                                     TerrainColumnCache* columns = nullptr);
+
+    // Chunk filled with a single state (0-bit storage, no index array)
+    static std::shared_ptr<const ChunkData> uniform(const ChunkPosition& position, BlockState state);
+
+    /**
+     * Build ChunkData from raw blockstate IDs (x + y*16 + z*256 order).
+     * The palette holds only the states actually present, so uniform chunks
+     * get a 0-bit storage with no index array.
+     */
+    static std::shared_ptr<const ChunkData> fromStateIds(
+        const ChunkPosition& position, const uint16_t* stateIds, uint32_t version);
+
+    /**
+     * Uncompressed binary encoding (palette + packed indices) used by region files.
+     * Version is not stored - deserialized chunks start at version 0.
      */
-    static std::shared_ptr<const ChunkData> generate(const ChunkPosition& position);
+    std::vector<uint8_t> serialize() const;
+
+    // Decode serialize() output. Returns nullptr if the data is malformed
+    static std::shared_ptr<const ChunkData> deserialize(
+        const ChunkPosition& position, const uint8_t* data, size_t size);
 
 private:
     const ChunkPosition position_;
     const ChunkPalette palette_;
-    const std::array<uint8_t, CHUNK_VOLUME> data_;
-    const bool empty_;
+    const PackedBlockStorage storage_;
+    const uint32_t nonAirCount_;  // Kept up to date by edits, so emptiness never needs a rescan
     const uint32_t version_;  // Incremented on each edit for mesh invalidation
-
-    static uint32_t getBlockIndex(uint32_t x, uint32_t y, uint32_t z) {
-        return x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE;
-    }
+    mutable std::atomic<bool> meshDirty_{true};  // Needs (re)meshing, see markMeshDirty()
+    mutable std::atomic<uint8_t> meshLod_{0};
 };
 
 // Type alias for the standard way to hold chunk data
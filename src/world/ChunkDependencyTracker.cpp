@@ -0,0 +1,87 @@
+#include "ChunkDependencyTracker.hpp"
+#include <tracy/Tracy.hpp>
+
+namespace FarHorizon {
+
+// ChunkNeighborhood index of the center chunk (never a dependency of itself)
+static constexpr size_t CENTER_INDEX = 13;
+
+bool ChunkDependencyTracker::waitForNeighbors(const ChunkPosition& pos, ChunkStage stage, const ReadyCheck& isReady) {
+    ZoneScoped;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint32_t pendingNeighbors = 0;
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                size_t index = ChunkNeighborhood::getIndex(dx, dy, dz);
+                if (index != CENTER_INDEX && !isReady(pos.getNeighbor(dx, dy, dz))) {
+                    pendingNeighbors |= 1u << index;
+                }
+            }
+        }
+    }
+
+    if (pendingNeighbors == 0) {
+        waiters_.erase(pos);
+        return false;
+    }
+
+    waiters_[pos] = {stage, pendingNeighbors};
+    return true;
+}
+
+void ChunkDependencyTracker::complete(const ChunkPosition& pos, ChunkStage stage, std::vector<ChunkPosition>& runnable) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (waiters_.empty()) {
+        return;
+    }
+
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                size_t index = ChunkNeighborhood::getIndex(dx, dy, dz);
+                if (index == CENTER_INDEX) {
+                    continue;
+                }
+
+                ChunkPosition neighborPos = pos.getNeighbor(dx, dy, dz);
+                auto it = waiters_.find(neighborPos);
+                if (it == waiters_.end() || it->second.stage != stage) {
+                    continue;
+                }
+
+                // The neighbor sees pos at the mirrored offset, which is index 26 - index
+                it->second.pendingNeighbors &= ~(1u << (26 - index));
+                if (it->second.pendingNeighbors == 0) {
+                    runnable.push_back(neighborPos);
+                    waiters_.erase(it);
+                }
+            }
+        }
+    }
+}
+
+std::vector<ChunkPosition> ChunkDependencyTracker::releaseAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<ChunkPosition> released;
+    released.reserve(waiters_.size());
+    for (const auto& [pos, waiter] : waiters_) {
+        released.push_back(pos);
+    }
+    waiters_.clear();
+    return released;
+}
+
+void ChunkDependencyTracker::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    waiters_.clear();
+}
+
+size_t ChunkDependencyTracker::getWaitingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return waiters_.size();
+}
+
+} // namespace FarHorizon
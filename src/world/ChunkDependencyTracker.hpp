@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Chunk.hpp"
+#include "ChunkStorage.hpp"
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace FarHorizon {
+
+/**
+ * Pipeline stages a chunk passes through before it can be meshed.
+ */
+enum class ChunkStage : uint8_t {
+    Generated,  // Blocks are in ChunkStorage
+    Lit         // LightEngine has published light
+};
+
+/**
+ * Parks chunk jobs until their neighbors reach a stage, instead of re-queueing
+ * them and letting workers spin on chunks that aren't ready.
+ *
+ * All 26 neighbors count (the mesher reads edge and corner chunks too). Each
+ * parked chunk keeps a pending mask with one bit per neighbor still missing,
+ * indexed like ChunkNeighborhood. complete() clears the matching bit on the
+ * surrounding chunks. A chunk becomes runnable again once its mask is empty.
+ *
+ * Thread safety: all public methods are thread-safe. Readiness is re-checked
+ * under the tracker lock, so a neighbor that completes while a chunk is being
+ * parked is never missed, as long as complete() is called after the stage's
+ * result becomes visible.
+ */
+class ChunkDependencyTracker {
+public:
+    using ReadyCheck = std::function<bool(const ChunkPosition&)>;
+
+    ChunkDependencyTracker() = default;
+
+    // Non-copyable, non-movable (contains a mutex)
+    ChunkDependencyTracker(const ChunkDependencyTracker&) = delete;
+    ChunkDependencyTracker& operator=(const ChunkDependencyTracker&) = delete;
+
+    /**
+     * Park pos until every neighbor passes isReady for the given stage.
+     * @return false if all neighbors are ready already (nothing parked, run the job now)
+     */
+    bool waitForNeighbors(const ChunkPosition& pos, ChunkStage stage, const ReadyCheck& isReady);
+
+    /**
+     * pos reached stage. Appends parked neighbors whose last dependency this was to
+     * runnable (they are no longer tracked and must be resubmitted by the caller).
+     */
+    void complete(const ChunkPosition& pos, ChunkStage stage, std::vector<ChunkPosition>& runnable);
+
+    /**
+     * Hand back every parked chunk, for when readiness rules change (camera moved:
+     * neighbors that left render distance no longer count as dependencies).
+     */
+    std::vector<ChunkPosition> releaseAll();
+
+    void clear();
+
+    size_t getWaitingCount() const;
+
+private:
+    struct Waiter {
+        ChunkStage stage;
+        uint32_t pendingNeighbors;  // Bit per ChunkNeighborhood index that hasn't reached stage yet
+    };
+
+    std::unordered_map<ChunkPosition, Waiter, ChunkPositionHash> waiters_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace FarHorizon
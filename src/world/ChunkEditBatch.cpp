@@ -0,0 +1,63 @@
+#include "ChunkEditBatch.hpp"
+
+namespace FarHorizon {
+
+static glm::ivec3 getLocalPos(const glm::ivec3& worldPos, const ChunkPosition& chunkPos) {
+    return worldPos - glm::ivec3(
+        chunkPos.x * static_cast<int32_t>(CHUNK_SIZE),
+        chunkPos.y * static_cast<int32_t>(CHUNK_SIZE),
+        chunkPos.z * static_cast<int32_t>(CHUNK_SIZE)
+    );
+}
+
+void ChunkEditBatch::setBlockState(const glm::ivec3& worldPos, BlockState state) {
+    ChunkPosition chunkPos = ChunkPosition::fromBlockCoords(worldPos.x, worldPos.y, worldPos.z);
+    glm::ivec3 localPos = getLocalPos(worldPos, chunkPos);
+
+    ChunkEdits& chunk = chunks_[chunkPos];
+    chunk.blocks[static_cast<uint16_t>(ChunkData::getBlockIndex(localPos.x, localPos.y, localPos.z))] = state;
+
+    // Same order as ChunkPosition::getFaceNeighborOffsets(): West, East, Down, Up, North, South
+    constexpr int32_t last = static_cast<int32_t>(CHUNK_SIZE) - 1;
+    if (localPos.x == 0)    chunk.touchedFaces |= 1 << 0;
+    if (localPos.x == last) chunk.touchedFaces |= 1 << 1;
+    if (localPos.y == 0)    chunk.touchedFaces |= 1 << 2;
+    if (localPos.y == last) chunk.touchedFaces |= 1 << 3;
+    if (localPos.z == 0)    chunk.touchedFaces |= 1 << 4;
+    if (localPos.z == last) chunk.touchedFaces |= 1 << 5;
+}
+
+BlockState ChunkEditBatch::getBlockState(const glm::ivec3& worldPos) const {
+    ChunkPosition chunkPos = ChunkPosition::fromBlockCoords(worldPos.x, worldPos.y, worldPos.z);
+
+    auto chunkIt = chunks_.find(chunkPos);
+    if (chunkIt != chunks_.end()) {
+        glm::ivec3 localPos = getLocalPos(worldPos, chunkPos);
+        auto blockIt = chunkIt->second.blocks.find(
+            static_cast<uint16_t>(ChunkData::getBlockIndex(localPos.x, localPos.y, localPos.z)));
+        if (blockIt != chunkIt->second.blocks.end()) {
+            return blockIt->second;
+        }
+    }
+
+    return world_.getBlockState(worldPos);
+}
+
+size_t ChunkEditBatch::getEditCount() const {
+    size_t count = 0;
+    for (const auto& [pos, chunk] : chunks_) {
+        count += chunk.blocks.size();
+    }
+    return count;
+}
+
+std::vector<BlockEdit> ChunkEditBatch::ChunkEdits::toEdits() const {
+    std::vector<BlockEdit> edits;
+    edits.reserve(blocks.size());
+    for (const auto& [index, state] : blocks) {
+        edits.push_back({index, state});
+    }
+    return edits;
+}
+
+} // namespace FarHorizon
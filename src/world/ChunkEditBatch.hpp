@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ChunkData.hpp"
+#include "physics/BlockGetter.hpp"
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace FarHorizon {
+
+/**
+ * Collects block edits grouped by chunk so they can be applied together.
+ *
+ * ChunkManager::applyEdits() turns each touched chunk into exactly one
+ * copy-on-write ChunkData and queues every affected chunk for remeshing once,
+ * instead of one 4096-block copy and up to 7 remeshes per edit.
+ *
+ * Reads through the batch see its own pending edits first, then the world,
+ * so cascading shape updates can be collected before anything is committed.
+ *
+ * Not thread-safe: build a batch on one thread.
+ */
+class ChunkEditBatch : public BlockGetter {
+public:
+    explicit ChunkEditBatch(const BlockGetter& world) : world_(world) {}
+
+    // Record an edit (replaces any pending edit of the same block)
+    void setBlockState(const glm::ivec3& worldPos, BlockState state);
+
+    // Pending edit at worldPos if any, otherwise the world's current state
+    BlockState getBlockState(const glm::ivec3& worldPos) const override;
+
+    bool empty() const { return chunks_.empty(); }
+    size_t getEditCount() const;
+
+    void clear() { chunks_.clear(); }
+
+    /**
+     * Pending edits for one chunk.
+     * touchedFaces has bit i set when an edit lies on the chunk boundary facing
+     * ChunkPosition::getFaceNeighborOffsets()[i] (that neighbor must be remeshed too).
+     */
+    struct ChunkEdits {
+        std::unordered_map<uint16_t, BlockState> blocks;  // Local block index -> new state
+        uint8_t touchedFaces = 0;
+
+        std::vector<BlockEdit> toEdits() const;
+    };
+
+    const std::unordered_map<ChunkPosition, ChunkEdits, ChunkPositionHash>& getChunkEdits() const { return chunks_; }
+
+private:
+    const BlockGetter& world_;
+    std::unordered_map<ChunkPosition, ChunkEdits, ChunkPositionHash> chunks_;
+};
+
+} // namespace FarHorizon
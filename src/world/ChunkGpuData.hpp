@@ -1,8 +1,10 @@
 #pragma once
 
+#include "ChunkData.hpp"
+#include "ChunkOccupancy.hpp"
 #include <glm/glm.hpp>
+#include <array>
 #include <cstdint>
-#include <vulkan/vulkan.h>
 #include <vector>
 
 namespace FarHorizon {
@@ -28,7 +30,9 @@ struct PackedLighting {
                ((blockR & 0x1F) << 10) | ((blockG & 0x1F) << 5) | (blockB & 0x1F);
     }
 
-    // Helper to create uniform lighting (for now, until lighting system is implemented)
+    bool operator==(const PackedLighting& other) const = default;
+
+    // Helper to create uniform lighting (all four corners equal)
     static PackedLighting uniform(uint8_t sunR, uint8_t sunG, uint8_t sunB) {
         PackedLighting lighting;
         uint32_t packed = packCorner(sunR, sunG, sunB, 0, 0, 0);
@@ -52,46 +56,28 @@ struct FaceData {
     // bits 5-9: Y position (0-31)
     // bits 10-14: Z position (0-31)
     // bit 15: isBackFace flag (reserved for future use)
-    // bits 16-31: lightIndex (GLOBAL index into lighting buffer)
+    // bits 16-31: lightIndex (index into the chunk's lighting, see ChunkGpuMetadata::lightingOffset)
     uint32_t packed1;
 
     // bits 0-15: quadIndex (reference to QuadInfo buffer which contains texture)
-    // bits 16-31: reserved for future use
+    // bits 16-19: merged width - 1 (greedy meshing, along the face's U axis)
+    // bits 20-23: merged height - 1 (greedy meshing, along the face's V axis)
+    // bit 24: split the quad along corners 1-3 instead of 0-2 (ambient occlusion)
+    // bits 25-31: reserved for future use
     uint32_t packed2;
 
     // Helper functions for packing/unpacking
+    // width/height > 1 stretch the quad over a rectangle of identical coplanar faces
     static FaceData pack(uint32_t x, uint32_t y, uint32_t z, bool isBackFace,
-                         uint32_t globalLightIndex, uint32_t quadIndex) {
+                         uint32_t lightIndex, uint32_t quadIndex,
+                         uint32_t width = 1, uint32_t height = 1, bool flipDiagonal = false) {
         FaceData data;
         data.packed1 = (x & 0x1F) | ((y & 0x1F) << 5) | ((z & 0x1F) << 10) |
-                       ((isBackFace ? 1u : 0u) << 15) | ((globalLightIndex & 0xFFFF) << 16);
-        data.packed2 = (quadIndex & 0xFFFF);
+                       ((isBackFace ? 1u : 0u) << 15) | ((lightIndex & 0xFFFF) << 16);
+        data.packed2 = (quadIndex & 0xFFFF) | (((width - 1) & 0xF) << 16) | (((height - 1) & 0xF) << 20) |
+                       ((flipDiagonal ? 1u : 0u) << 24);
         return data;
     }
-
-    static constexpr VkVertexInputBindingDescription getBindingDescription() {
-        VkVertexInputBindingDescription binding{};
-        binding.binding = 0;
-        binding.stride = sizeof(FaceData);
-        binding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;  // One FaceData per face instance
-        return binding;
-    }
-
-    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions() {
-        std::vector<VkVertexInputAttributeDescription> attributes(2);
-
-        attributes[0].binding = 0;
-        attributes[0].location = 0;
-        attributes[0].format = VK_FORMAT_R32_UINT;
-        attributes[0].offset = offsetof(FaceData, packed1);
-
-        attributes[1].binding = 0;
-        attributes[1].location = 1;
-        attributes[1].format = VK_FORMAT_R32_UINT;
-        attributes[1].offset = offsetof(FaceData, packed2);
-
-        return attributes;
-    }
 };
 
 // Verify size (8 bytes total)
@@ -131,13 +117,34 @@ struct QuadInfo {
 // Verify alignment (size will be 120 bytes with std430 layout)
 static_assert(alignof(QuadInfo) == 16, "QuadInfo must be 16-byte aligned");
 
+/**
+ * Faces of a chunk mesh are grouped by the direction they face so whole groups
+ * pointing away from the camera can be skipped. Buckets 0-5 follow FaceUtils::toIndex;
+ * the last one holds quads not lying flat on their face's axis (always drawn).
+ */
+static constexpr int FACE_BUCKET_COUNT = 7;
+static constexpr int FACE_BUCKET_UNALIGNED = 6;
+
 /**
  * Mesh data for a chunk using compact format.
  */
 struct CompactChunkMesh {
-    std::vector<FaceData> faces;
+    std::vector<FaceData> faces;  // Sorted by bucket
     std::vector<PackedLighting> lighting;
+    std::array<uint32_t, FACE_BUCKET_COUNT> bucketCounts{};  // Faces per bucket, in bucket order
+    uint16_t connectivity = FACE_CONNECTIVITY_ALL;  // Face pairs joined through open blocks (ChunkOccupancy)
     ChunkPosition position;
+    uint32_t version = 0;   // ChunkData::getVersion() of the meshed chunk
+    uint64_t sequence = 0;  // Taken before the snapshot: a newer change to the inputs gets a higher one
+
+    // Chunk-local bounds of the block cells that emitted faces (min > max while there are none)
+    glm::ivec3 boundsMin = glm::ivec3(CHUNK_SIZE);
+    glm::ivec3 boundsMax = glm::ivec3(0);
+
+    void growBounds(const glm::ivec3& min, const glm::ivec3& max) {
+        boundsMin = glm::min(boundsMin, min);
+        boundsMax = glm::max(boundsMax, max);
+    }
 };
 
 /**
@@ -146,16 +153,19 @@ struct CompactChunkMesh {
  */
 struct alignas(16) ChunkGpuMetadata {
     alignas(16) glm::ivec3 position;  // Chunk world position in blocks (chunkX * 16, chunkY * 16, chunkZ * 16)
-    uint32_t faceOffset;               // Offset into both FaceData AND lighting buffers (same index for both)
+    uint32_t faceOffset;               // Offset into the FaceData buffer
+    uint32_t lightingOffset;           // Offset into the lighting buffer (FaceData light indices are relative to it)
+    uint32_t _padding[3];
 
-    static ChunkGpuMetadata create(const ChunkPosition& chunkPos, uint32_t bufferOffset) {
+    static ChunkGpuMetadata create(const ChunkPosition& chunkPos, uint32_t faceOffset, uint32_t lightingOffset) {
         ChunkGpuMetadata data{};
         data.position = glm::ivec3(chunkPos.x * CHUNK_SIZE, chunkPos.y * CHUNK_SIZE, chunkPos.z * CHUNK_SIZE);
-        data.faceOffset = bufferOffset;
+        data.faceOffset = faceOffset;
+        data.lightingOffset = lightingOffset;
         return data;
     }
 };
 
-static_assert(sizeof(ChunkGpuMetadata) == 16, "ChunkGpuMetadata must be 16 bytes");
+static_assert(sizeof(ChunkGpuMetadata) == 32, "ChunkGpuMetadata must be 32 bytes");
 
 } // namespace FarHorizon
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "ChunkJobScheduler.hpp"
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace FarHorizon {
+
+// How strongly the view direction discounts distance (0 = distance only).
+// A chunk straight ahead at distance d sorts like one at d * (1 - VIEW_WEIGHT).
+static constexpr float VIEW_WEIGHT = 0.5f;
+
+ChunkJobScheduler::ChunkJobScheduler(size_t workerCount) {
+    workerCount = std::max<size_t>(1, workerCount);
+    workers_.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        workers_.push_back(std::make_unique<WorkerQueue>());
+    }
+}
+
+float ChunkJobScheduler::computePriority(const ChunkPosition& pos, const CameraState& camera) const {
+    glm::vec3 offset(
+        static_cast<float>(pos.x - camera.chunk.x),
+        static_cast<float>(pos.y - camera.chunk.y),
+        static_cast<float>(pos.z - camera.chunk.z)
+    );
+
+    float distance = glm::length(offset);
+    if (distance < 1e-3f) {
+        return 0.0f;
+    }
+
+    // viewDirection is zero when unknown, which degrades to plain distance ordering
+    float alignment = glm::dot(offset / distance, camera.viewDirection);
+    return distance * (1.0f - VIEW_WEIGHT * alignment);
+}
+
+ChunkJobScheduler::CameraState ChunkJobScheduler::getCamera() const {
+    std::lock_guard<std::mutex> lock(cameraMutex_);
+    return camera_;
+}
+
+size_t ChunkJobScheduler::updateCamera(const ChunkPosition& cameraChunk, const glm::vec3& viewDirection,
+                                       int32_t renderDistance) {
+    ZoneScoped;
+
+    CameraState camera;
+    camera.chunk = cameraChunk;
+    camera.viewDirection = glm::length(viewDirection) > 1e-3f ? glm::normalize(viewDirection) : glm::vec3(0.0f);
+    camera.renderDistance = renderDistance;
+
+    {
+        std::lock_guard<std::mutex> lock(cameraMutex_);
+        camera_ = camera;
+    }
+
+    const float dropRadius = static_cast<float>(renderDistance + 1);
+    size_t dropped = 0;
+
+    // Held throughout so a concurrent submit can't merge into a job we are dropping
+    std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+
+    for (auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+
+        auto& heap = worker->heap;
+        auto keepEnd = std::remove_if(heap.begin(), heap.end(), [&](const Job& job) {
+            if (job.position.distanceTo(cameraChunk) > dropRadius) {
+                pending_.erase(job.position);
+                dropped++;
+                return true;
+            }
+            return false;
+        });
+        heap.erase(keepEnd, heap.end());
+
+        for (auto& job : heap) {
+            job.priority = computePriority(job.position, camera);
+        }
+        std::make_heap(heap.begin(), heap.end(), JobCompare{});
+    }
+
+    pendingJobs_.fetch_sub(dropped, std::memory_order_relaxed);
+    return dropped;
+}
+
+void ChunkJobScheduler::pushJobs(size_t workerIndex, const std::vector<Job>& jobs) {
+    WorkerQueue& worker = *workers_[workerIndex];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    for (const auto& job : jobs) {
+        worker.heap.push_back(job);
+        std::push_heap(worker.heap.begin(), worker.heap.end(), JobCompare{});
+    }
+}
+
+bool ChunkJobScheduler::submit(const MeshWorkItem& item) {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        auto [it, inserted] = pending_.try_emplace(item.position, item.isNewChunk);
+        if (!inserted) {
+            it->second = it->second || item.isNewChunk;
+            return false;
+        }
+        pendingJobs_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job job{item.position, computePriority(item.position, getCamera())};
+    size_t workerIndex = nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    pushJobs(workerIndex, {job});
+
+    wakeWorkers(false);
+    return true;
+}
+
+size_t ChunkJobScheduler::submitBatch(const std::vector<MeshWorkItem>& items) {
+    ZoneScoped;
+
+    std::vector<Job> jobs;
+    jobs.reserve(items.size());
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        for (const auto& item : items) {
+            auto [it, inserted] = pending_.try_emplace(item.position, item.isNewChunk);
+            if (!inserted) {
+                it->second = it->second || item.isNewChunk;
+                continue;
+            }
+            jobs.push_back({item.position, 0.0f});
+        }
+        pendingJobs_.fetch_add(jobs.size(), std::memory_order_relaxed);
+    }
+
+    if (jobs.empty()) {
+        return 0;
+    }
+
+    CameraState camera = getCamera();
+    for (auto& job : jobs) {
+        job.priority = computePriority(job.position, camera);
+    }
+
+    // Deal jobs round-robin so every worker starts with a share of the nearest chunks
+    std::vector<std::vector<Job>> perWorker(workers_.size());
+    size_t firstWorker = nextWorker_.fetch_add(jobs.size(), std::memory_order_relaxed);
+    for (size_t i = 0; i < jobs.size(); i++) {
+        perWorker[(firstWorker + i) % workers_.size()].push_back(jobs[i]);
+    }
+    for (size_t w = 0; w < workers_.size(); w++) {
+        if (!perWorker[w].empty()) {
+            pushJobs(w, perWorker[w]);
+        }
+    }
+
+    wakeWorkers(true);
+    return jobs.size();
+}
+
+void ChunkJobScheduler::wakeWorkers(bool all) {
+    // Taking the sleep mutex orders this against a worker between its predicate check and wait()
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    if (all) {
+        sleepCV_.notify_all();
+    } else {
+        sleepCV_.notify_one();
+    }
+}
+
+bool ChunkJobScheduler::popFrom(WorkerQueue& queue, Job& job) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.heap.empty()) {
+        return false;
+    }
+
+    std::pop_heap(queue.heap.begin(), queue.heap.end(), JobCompare{});
+    job = queue.heap.back();
+    queue.heap.pop_back();
+    return true;
+}
+
+bool ChunkJobScheduler::tryPop(size_t workerIndex, MeshWorkItem& item) {
+    Job job;
+    bool found = popFrom(*workers_[workerIndex], job);
+
+    // Steal: take the best head among the other workers
+    if (!found) {
+        size_t victim = workers_.size();
+        float bestPriority = 0.0f;
+        for (size_t i = 1; i < workers_.size(); i++) {
+            size_t index = (workerIndex + i) % workers_.size();
+            WorkerQueue& other = *workers_[index];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            if (!other.heap.empty() && (victim == workers_.size() || other.heap.front().priority < bestPriority)) {
+                victim = index;
+                bestPriority = other.heap.front().priority;
+            }
+        }
+        if (victim != workers_.size()) {
+            found = popFrom(*workers_[victim], job);
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    // Flags live in pending_ so merges made while queued are honored
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    auto it = pending_.find(job.position);
+    if (it == pending_.end()) {
+        return false;  // Cleared while we held it
+    }
+    item.position = job.position;
+    item.isNewChunk = it->second;
+    pending_.erase(it);
+    pendingJobs_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ChunkJobScheduler::waitAndPop(size_t workerIndex, MeshWorkItem& item) {
+    while (!stopped_.load(std::memory_order_relaxed)) {
+        if (tryPop(workerIndex, item)) {
+            return true;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCV_.wait(lock, [this] {
+            return pendingJobs_.load(std::memory_order_relaxed) > 0 || stopped_.load(std::memory_order_relaxed);
+        });
+    }
+    return false;
+}
+
+void ChunkJobScheduler::clear() {
+    std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+    for (auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->heap.clear();
+    }
+    pending_.clear();
+    pendingJobs_.store(0, std::memory_order_relaxed);
+}
+
+void ChunkJobScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopped_.store(true, std::memory_order_relaxed);
+    }
+    sleepCV_.notify_all();
+}
+
+} // namespace FarHorizon
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Chunk.hpp"
+#include <glm/glm.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace FarHorizon {
+
+/**
+ * Work item for mesh generation queue.
+ */
+struct MeshWorkItem {
+    ChunkPosition position;
+    bool isNewChunk;  // True if queued to load or generate the chunk
+};
+
+/**
+ * Camera-priority job scheduler for chunk generation and meshing.
+ *
+ * Design:
+ * - One priority heap per worker; owners pop their own best job, idle workers
+ *   steal the best job from the other workers
+ * - Priority = distance to the camera chunk, discounted for chunks in front of the camera
+ * - Positions are deduplicated: re-submitting a queued chunk only merges its flags
+ * - Moving the camera re-prioritizes every queued job and drops the ones that left
+ *   render distance
+ *
+ * Thread safety: all public methods are thread-safe.
+ */
+class ChunkJobScheduler {
+public:
+    explicit ChunkJobScheduler(size_t workerCount);
+
+    // Non-copyable, non-movable (contains mutexes)
+    ChunkJobScheduler(const ChunkJobScheduler&) = delete;
+    ChunkJobScheduler& operator=(const ChunkJobScheduler&) = delete;
+
+    size_t getWorkerCount() const { return workers_.size(); }
+
+    /**
+     * Update the camera used for prioritization.
+     * Re-prioritizes queued jobs and drops jobs further than renderDistance + 1 chunks
+     * (the unload radius). viewDirection may be zero (distance-only ordering).
+     * @return Number of stale jobs dropped
+     */
+    size_t updateCamera(const ChunkPosition& cameraChunk, const glm::vec3& viewDirection, int32_t renderDistance);
+
+    /**
+     * Queue a job. Returns false if the position was already queued
+     * (isNewChunk is merged into the queued job instead).
+     */
+    bool submit(const MeshWorkItem& item);
+
+    /**
+     * Queue many jobs at once (one lock per worker heap instead of one per job).
+     * @return Number of jobs actually queued (not already pending)
+     */
+    size_t submitBatch(const std::vector<MeshWorkItem>& items);
+
+    /**
+     * Block until a job is available for this worker (own heap first, then stealing).
+     * @return false once stop() was called
+     */
+    bool waitAndPop(size_t workerIndex, MeshWorkItem& item);
+
+    // Drop every queued job
+    void clear();
+
+    // Wake all workers and make waitAndPop() return false
+    void stop();
+
+    size_t getPendingCount() const { return pendingJobs_.load(std::memory_order_relaxed); }
+
+private:
+    struct Job {
+        ChunkPosition position;
+        float priority;  // Lower runs first
+    };
+
+    // Min-heap ordering on priority for std::push_heap/pop_heap
+    struct JobCompare {
+        bool operator()(const Job& a, const Job& b) const { return a.priority > b.priority; }
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::vector<Job> heap;
+    };
+
+    struct CameraState {
+        ChunkPosition chunk{0, 0, 0};
+        glm::vec3 viewDirection{0.0f};
+        int32_t renderDistance = 0;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> workers_;
+    std::atomic<size_t> nextWorker_{0};  // Round-robin target for single submits
+
+    // Queued positions -> isNewChunk (dedup and flag merging)
+    std::unordered_map<ChunkPosition, bool, ChunkPositionHash> pending_;
+    std::mutex pendingMutex_;
+    std::atomic<size_t> pendingJobs_{0};
+
+    CameraState camera_;
+    mutable std::mutex cameraMutex_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCV_;
+    std::atomic<bool> stopped_{false};
+
+    float computePriority(const ChunkPosition& pos, const CameraState& camera) const;
+    CameraState getCamera() const;
+    bool tryPop(size_t workerIndex, MeshWorkItem& item);
+    bool popFrom(WorkerQueue& queue, Job& job);
+    void pushJobs(size_t workerIndex, const std::vector<Job>& jobs);
+    void wakeWorkers(bool all);
+};
+
+} // namespace FarHorizon
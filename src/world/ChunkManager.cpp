@@ -3,8 +3,11 @@
 #include "BlockRegistry.hpp"
 #include <tracy/Tracy.hpp>
 #include <cmath>
+#include <algorithm>
+#include <bit>
 #include <spdlog/spdlog.h>
 #include <functional>
+#include <limits>
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace FarHorizon {
@@ -90,6 +93,265 @@ static FaceDirection rotateXFace(FaceDirection face, int degrees) {
     return face;
 }
 
+// Biome tint for tinted quads (grass), multiplied into both light channels
+static constexpr uint32_t TINT_R = 121;
+static constexpr uint32_t TINT_G = 192;
+static constexpr uint32_t TINT_B = 90;
+
+// Corner brightness in percent by ambient occlusion level (0 = both sides blocked, 3 = open)
+static constexpr uint32_t AO_BRIGHTNESS[4] = {50, 65, 82, 100};
+
+struct PackedLightingHash {
+    size_t operator()(const PackedLighting& lighting) const {
+        size_t hash = 0;
+        for (uint32_t corner : lighting.corners) {
+            hash = hash * 0x9E3779B97F4A7C15ull + corner;
+        }
+        return hash ^ (hash >> 29);
+    }
+};
+
+// ===== Greedy Meshing Helper Functions =====
+
+// Sentinel for an empty cell in the greedy face mask
+static constexpr uint32_t GREEDY_EMPTY = 0xFFFFFFFF;
+
+// In-plane (u, v) axes and the slice axis for each face direction.
+// Must match the merge axes used by the chunk vertex shader.
+static void getGreedyAxes(FaceDirection dir, int& uAxis, int& vAxis, int& layerAxis) {
+    switch (dir) {
+        case FaceDirection::DOWN:
+        case FaceDirection::UP:
+            uAxis = 0; vAxis = 2; layerAxis = 1;
+            break;
+        case FaceDirection::NORTH:
+        case FaceDirection::SOUTH:
+            uAxis = 0; vAxis = 1; layerAxis = 2;
+            break;
+        case FaceDirection::WEST:
+        case FaceDirection::EAST:
+            uAxis = 2; vAxis = 1; layerAxis = 0;
+            break;
+    }
+}
+
+// Only quads covering the whole block face with one full texture tile can be stretched:
+// the shader extends corners by whole blocks and UVs by whole tiles (REPEAT sampler)
+static bool isGreedyMergeable(FaceDirection dir, const glm::vec3 corners[4], const glm::vec2 uvs[4]) {
+    constexpr float EPSILON = 1e-5f;
+
+    int uAxis, vAxis, layerAxis;
+    getGreedyAxes(dir, uAxis, vAxis, layerAxis);
+
+    glm::vec3 cornerMin = corners[0], cornerMax = corners[0];
+    glm::vec2 uvMin = uvs[0], uvMax = uvs[0];
+    for (int i = 1; i < 4; i++) {
+        cornerMin = glm::min(cornerMin, corners[i]);
+        cornerMax = glm::max(cornerMax, corners[i]);
+        uvMin = glm::min(uvMin, uvs[i]);
+        uvMax = glm::max(uvMax, uvs[i]);
+    }
+
+    return cornerMin[uAxis] < EPSILON && cornerMax[uAxis] > (1.0f - EPSILON) &&
+           cornerMin[vAxis] < EPSILON && cornerMax[vAxis] > (1.0f - EPSILON) &&
+           std::abs(uvMax.x - uvMin.x - 1.0f) < EPSILON &&
+           std::abs(uvMax.y - uvMin.y - 1.0f) < EPSILON;
+}
+
+static uint32_t getGreedyCellIndex(FaceDirection dir, uint32_t x, uint32_t y, uint32_t z) {
+    int uAxis, vAxis, layerAxis;
+    getGreedyAxes(dir, uAxis, vAxis, layerAxis);
+
+    const uint32_t pos[3] = {x, y, z};
+    return static_cast<uint32_t>(FaceUtils::toIndex(dir)) * CHUNK_VOLUME +
+           pos[layerAxis] * CHUNK_SIZE * CHUNK_SIZE + pos[vAxis] * CHUNK_SIZE + pos[uAxis];
+}
+
+// Per-thread greedy face mask, all cells GREEDY_EMPTY between meshes (emitGreedyFaces clears it)
+static std::vector<uint32_t>& getGreedyMask() {
+    thread_local std::vector<uint32_t> mask(6 * CHUNK_VOLUME, GREEDY_EMPTY);
+    return mask;
+}
+
+// Faces collected per bucket while meshing, concatenated in bucket order at the end
+using FaceBuckets = std::array<std::vector<FaceData>, FACE_BUCKET_COUNT>;
+
+// Per-thread bucket storage, emptied for the next mesh
+static FaceBuckets& getFaceBuckets() {
+    thread_local FaceBuckets buckets;
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    return buckets;
+}
+
+static void appendFaceBuckets(const FaceBuckets& buckets, CompactChunkMesh& mesh) {
+    size_t faceCount = 0;
+    for (const auto& bucket : buckets) {
+        faceCount += bucket.size();
+    }
+    mesh.faces.reserve(faceCount);
+    for (int i = 0; i < FACE_BUCKET_COUNT; i++) {
+        mesh.faces.insert(mesh.faces.end(), buckets[i].begin(), buckets[i].end());
+        mesh.bucketCounts[i] = static_cast<uint32_t>(buckets[i].size());
+    }
+}
+
+// Sweep every slice of the mask and emit one stretched face per maximal rectangle of equal keys.
+// Keys are (lightIndex << 16) | quadIndex. The mask is left cleared for reuse.
+static void emitGreedyFaces(std::vector<uint32_t>& mask, CompactChunkMesh& mesh, FaceBuckets& buckets) {
+    for (int dirIndex = 0; dirIndex < 6; dirIndex++) {
+        int uAxis, vAxis, layerAxis;
+        getGreedyAxes(FaceUtils::fromIndex(dirIndex), uAxis, vAxis, layerAxis);
+
+        for (uint32_t layer = 0; layer < CHUNK_SIZE; layer++) {
+            uint32_t* slice = mask.data() + dirIndex * CHUNK_VOLUME + layer * CHUNK_SIZE * CHUNK_SIZE;
+
+            for (uint32_t v = 0; v < CHUNK_SIZE; v++) {
+                for (uint32_t u = 0; u < CHUNK_SIZE; u++) {
+                    uint32_t key = slice[v * CHUNK_SIZE + u];
+                    if (key == GREEDY_EMPTY) {
+                        continue;
+                    }
+
+                    uint32_t width = 1;
+                    while (u + width < CHUNK_SIZE && slice[v * CHUNK_SIZE + u + width] == key) {
+                        width++;
+                    }
+
+                    uint32_t height = 1;
+                    while (v + height < CHUNK_SIZE) {
+                        bool rowMatches = true;
+                        for (uint32_t du = 0; du < width; du++) {
+                            if (slice[(v + height) * CHUNK_SIZE + u + du] != key) {
+                                rowMatches = false;
+                                break;
+                            }
+                        }
+                        if (!rowMatches) {
+                            break;
+                        }
+                        height++;
+                    }
+
+                    for (uint32_t dv = 0; dv < height; dv++) {
+                        for (uint32_t du = 0; du < width; du++) {
+                            slice[(v + dv) * CHUNK_SIZE + u + du] = GREEDY_EMPTY;
+                        }
+                    }
+
+                    uint32_t pos[3];
+                    pos[uAxis] = u;
+                    pos[vAxis] = v;
+                    pos[layerAxis] = layer;
+                    buckets[dirIndex].push_back(FaceData::pack(pos[0], pos[1], pos[2], false,
+                                                               key >> 16, key & 0xFFFF, width, height));
+
+                    glm::ivec3 extent(1);
+                    extent[uAxis] = static_cast<int>(width);
+                    extent[vAxis] = static_cast<int>(height);
+                    glm::ivec3 origin(pos[0], pos[1], pos[2]);
+                    mesh.growBounds(origin, origin + extent);
+                }
+            }
+        }
+    }
+}
+
+// ===== Smooth Lighting Helper Functions =====
+
+// Gather packed light and opacity for the chunk plus a one-block border from all 26 neighbors,
+// indexed like PaddedChunkSnapshot
+static void buildPaddedLight(const ChunkLightNeighborhood& neighborhood, uint8_t* light, uint8_t* opaque) {
+    ZoneScoped;
+
+    // Per padded coordinate: neighbor offset and the coordinate inside that neighbor
+    constexpr int SIZE = PaddedChunkSnapshot::SIZE;
+    int offsets[SIZE];
+    uint32_t locals[SIZE];
+    for (int p = 0; p < SIZE; p++) {
+        int c = p - 1;
+        offsets[p] = c < 0 ? -1 : (c >= static_cast<int>(CHUNK_SIZE) ? 1 : 0);
+        locals[p] = static_cast<uint32_t>(c - offsets[p] * static_cast<int>(CHUNK_SIZE));
+    }
+
+    int index = 0;
+    for (int pz = 0; pz < SIZE; pz++) {
+        for (int py = 0; py < SIZE; py++) {
+            for (int px = 0; px < SIZE; px++, index++) {
+                const ChunkLightData& source = *neighborhood.get(offsets[px], offsets[py], offsets[pz]);
+                uint32_t sourceIndex = ChunkData::getBlockIndex(locals[px], locals[py], locals[pz]);
+                light[index] = source.getPacked(sourceIndex);
+                opaque[index] = source.isOpaque(sourceIndex) ? 1 : 0;
+            }
+        }
+    }
+}
+
+// 5-bit sky and block light as one corner, with the biome tint applied to tinted quads
+static uint32_t packCornerLight(uint32_t sky, uint32_t block, bool tinted) {
+    if (!tinted) {
+        return PackedLighting::packCorner(sky, sky, sky, block, block, block);
+    }
+    return PackedLighting::packCorner((sky * TINT_R) / 255, (sky * TINT_G) / 255, (sky * TINT_B) / 255,
+                                      (block * TINT_R) / 255, (block * TINT_G) / 255, (block * TINT_B) / 255);
+}
+
+// Light at one quad corner, from the four cells touching the corner in the sampled layer.
+// Smooth light averages the cells that don't block light (skipping the diagonal when both
+// edge cells block it); without light data the corner gets full sky light. Classic 3-neighbor
+// ambient occlusion from the full-cube occluders among the same cells then darkens it.
+static uint32_t computeCornerLight(const uint8_t* light, const uint8_t* opaque, const uint8_t* occluders,
+                                   int base, int uStep, int vStep, bool tinted) {
+    const int samples[4] = {base, base + uStep, base + vStep, base + uStep + vStep};
+
+    uint32_t sky = 31;
+    uint32_t block = 0;
+    if (light) {
+        const bool diagonalHidden = opaque[samples[1]] && opaque[samples[2]];
+
+        uint32_t skySum = 0;
+        uint32_t blockSum = 0;
+        uint32_t count = 0;
+        for (int i = 0; i < 4; i++) {
+            if (opaque[samples[i]] || (i == 3 && diagonalHidden)) {
+                continue;
+            }
+            skySum += light[samples[i]] & 0x0F;
+            blockSum += light[samples[i]] >> 4;
+            count++;
+        }
+        if (count == 0) {
+            skySum = light[base] & 0x0F;
+            blockSum = light[base] >> 4;
+            count = 1;
+        }
+
+        // 0-15 averages to the 5-bit channels
+        sky = (skySum * 31) / (ChunkLightData::MAX_LIGHT * count);
+        block = (blockSum * 31) / (ChunkLightData::MAX_LIGHT * count);
+    }
+
+    const uint32_t side1 = occluders[samples[1]];
+    const uint32_t side2 = occluders[samples[2]];
+    const uint32_t corner = occluders[samples[3]];
+    const uint32_t ao = (side1 && side2) ? 0 : 3 - (side1 + side2 + corner);
+    sky = (sky * AO_BRIGHTNESS[ao]) / 100;
+    block = (block * AO_BRIGHTNESS[ao]) / 100;
+
+    return packCornerLight(sky, block, tinted);
+}
+
+// Split along corners 1-3 when they are brighter than 0-2, so a single dark (or bright)
+// corner doesn't bleed along the shared diagonal into both triangles
+static bool shouldFlipDiagonal(const PackedLighting& lighting) {
+    auto brightness = [](uint32_t corner) {
+        return ((corner >> 20) & 0x1F) + ((corner >> 5) & 0x1F);  // Sun green + block green
+    };
+    return brightness(lighting.corners[1]) + brightness(lighting.corners[3]) >
+           brightness(lighting.corners[0]) + brightness(lighting.corners[2]);
+}
+
 // ===== QuadInfoLibrary Implementation =====
 
 bool QuadInfoLibrary::QuadKey::operator==(const QuadKey& other) const {
@@ -132,6 +394,18 @@ uint32_t QuadInfoLibrary::getOrCreateQuad(const glm::vec3& normal,
     }
     key.textureSlot = textureSlot;
 
+    // Fast path: existing quad under a shared lock
+    {
+        std::shared_lock lock(mutex_);
+        auto it = quadMap_.find(key);
+        if (it != quadMap_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock(mutex_);
+
+    // Another thread may have inserted it between the two locks
     auto it = quadMap_.find(key);
     if (it != quadMap_.end()) {
         return it->second;
@@ -162,24 +436,52 @@ uint32_t QuadInfoLibrary::getOrCreateQuad(const glm::vec3& normal,
     return index;
 }
 
+size_t QuadInfoLibrary::size() const {
+    std::shared_lock lock(mutex_);
+    return quads_.size();
+}
+
+size_t QuadInfoLibrary::copyQuads(size_t first, size_t count, QuadInfo* dest) const {
+    std::shared_lock lock(mutex_);
+    if (first >= quads_.size()) {
+        return 0;
+    }
+
+    size_t copied = std::min(count, quads_.size() - first);
+    std::copy_n(quads_.begin() + first, copied, dest);
+    return copied;
+}
+
+void QuadInfoLibrary::clear() {
+    std::unique_lock lock(mutex_);
+    quads_.clear();
+    quadMap_.clear();
+}
+
 // ===== ChunkManager Implementation =====
 
-ChunkManager::ChunkManager() {
-    unsigned int numThreads = std::max(1u, std::thread::hardware_concurrency() / 2);
-    for (unsigned int i = 0; i < numThreads; i++) {
-        workerThreads_.emplace_back(&ChunkManager::meshWorker, this, i);
+ChunkManager::ChunkManager(std::unique_ptr<TerrainGenerator> terrainGenerator)
+    : terrainGenerator_(terrainGenerator ? std::move(terrainGenerator) : std::make_unique<HeightmapTerrainGenerator>())
+    , scheduler_(std::max(1u, std::thread::hardware_concurrency() / 2)) {
+    size_t numThreads = scheduler_.getWorkerCount();
+    for (size_t i = 0; i < numThreads; i++) {
+        workerThreads_.emplace_back(&ChunkManager::meshWorker, this, static_cast<unsigned int>(i));
     }
-    spdlog::info("ChunkManager initialized with {} mesh worker threads (lock-free architecture)", numThreads);
+    spdlog::info("ChunkManager initialized with {} mesh worker threads (lock-free architecture, {} terrain)",
+                 numThreads, terrainGenerator_->getName());
 }
 
 ChunkManager::~ChunkManager() {
-    running_ = false;
-    workQueueCV_.notify_all();
+    scheduler_.stop();
     for (auto& thread : workerThreads_) {
         if (thread.joinable()) {
             thread.join();
         }
     }
+
+    // Write back everything still loaded before the I/O thread shuts down
+    saveAllChunks();
+    regionStorage_.close();
 }
 
 void ChunkManager::initializeBlockModels() {
@@ -200,6 +502,160 @@ std::vector<std::string> ChunkManager::getRequiredTextures() const {
 
 void ChunkManager::cacheTextureIndices() {
     modelManager_.cacheTextureIndices();
+    bakeBlockModels();
+}
+
+void ChunkManager::bakeBlockModels() {
+    ZoneScoped;
+
+    const auto& stateToModel = modelManager_.getStateToModelMap();
+
+    uint16_t maxStateId = 0;
+    for (const auto& [stateId, model] : stateToModel) {
+        maxStateId = std::max(maxStateId, stateId);
+    }
+
+    bakedModels_.clear();
+    bakedModels_.resize(static_cast<size_t>(maxStateId) + 1);
+
+    size_t quadCount = 0;
+    size_t fullCubeCount = 0;
+
+    for (const auto& [stateId, stateModel] : stateToModel) {
+        const BlockStateVariant* variant = modelManager_.getVariantByStateId(stateId);
+        const BlockModel* model = variant ? variant->model : stateModel;
+
+        BakedBlockModel& baked = bakedModels_[stateId];
+        baked.model = model;
+
+        if (!model || model->elements.empty()) {
+            continue;
+        }
+
+        int rotationX = variant ? variant->rotationX : 0;
+        int rotationY = variant ? variant->rotationY : 0;
+
+        for (const auto& element : model->elements) {
+            glm::vec3 elemFrom = element.from / 16.0f;
+            glm::vec3 elemTo = element.to / 16.0f;
+
+            if (rotationY != 0) {
+                elemFrom = applyYRotation(elemFrom, rotationY);
+                elemTo = applyYRotation(elemTo, rotationY);
+            }
+            if (rotationX != 0) {
+                elemFrom = applyXRotation(elemFrom, rotationX);
+                elemTo = applyXRotation(elemTo, rotationX);
+            }
+
+            glm::vec3 finalFrom = glm::min(elemFrom, elemTo);
+            glm::vec3 finalTo = glm::max(elemFrom, elemTo);
+
+            for (const auto& [faceDir, face] : element.faces) {
+                FaceDirection rotatedFaceDir = rotateXFace(rotateYFace(faceDir, rotationY), rotationX);
+
+                BakedQuad quad;
+                quad.face = rotatedFaceDir;
+                quad.tinted = face.tintindex.has_value();
+
+                if (face.cullface.has_value()) {
+                    FaceDirection rotatedCullface = rotateXFace(rotateYFace(face.cullface.value(), rotationY), rotationX);
+                    if (FaceUtils::faceReachesBoundary(rotatedCullface, elemFrom, elemTo)) {
+                        quad.cullface = rotatedCullface;
+                        quad.hasCullface = true;
+                    }
+                }
+
+                glm::vec3 corners[4];
+                FaceUtils::getFaceVertices(rotatedFaceDir, finalFrom, finalTo, corners);
+
+                glm::vec2 uvs[4];
+                FaceUtils::convertUVs(face.uv, uvs);
+
+                glm::vec3 normal = FaceUtils::getFaceNormal(rotatedFaceDir);
+                quad.quadIndex = static_cast<uint16_t>(
+                    quadLibrary_.getOrCreateQuad(normal, corners, uvs, face.textureIndex));
+
+                // Quads flat on their face's axis can only be seen from that side
+                int uAxis, vAxis, layerAxis;
+                getGreedyAxes(rotatedFaceDir, uAxis, vAxis, layerAxis);
+                bool axisAligned = true;
+                for (int i = 1; i < 4; i++) {
+                    axisAligned &= std::abs(corners[i][layerAxis] - corners[0][layerAxis]) < 1e-5f;
+                }
+                quad.bucket = static_cast<uint8_t>(axisAligned ? FaceUtils::toIndex(rotatedFaceDir)
+                                                               : FACE_BUCKET_UNALIGNED);
+                quad.greedyMergeable = axisAligned && isGreedyMergeable(rotatedFaceDir, corners, uvs);
+
+                // Which neighbor cells each corner's smooth light samples
+                for (int i = 0; i < 4; i++) {
+                    quad.cornerSides[i] = static_cast<uint8_t>((corners[i][uAxis] >= 0.5f ? 1 : 0) |
+                                                               (corners[i][vAxis] >= 0.5f ? 2 : 0));
+                }
+
+                baked.quads.push_back(quad);
+            }
+        }
+
+        quadCount += baked.quads.size();
+
+        // Full cube: one 0-16 element whose six faces each cull against their own direction
+        bool fullCube = model->elements.size() == 1 &&
+                        model->elements[0].from == glm::vec3(0.0f) &&
+                        model->elements[0].to == glm::vec3(16.0f) &&
+                        cullingSystem_.getBlockShape(BlockState(stateId), model).isFullCube();
+        if (fullCube) {
+            bool seen[6] = {};
+            for (const BakedQuad& quad : baked.quads) {
+                if (!quad.hasCullface || quad.cullface != quad.face) {
+                    fullCube = false;
+                    break;
+                }
+                seen[FaceUtils::toIndex(quad.face)] = true;
+            }
+            for (int i = 0; i < 6 && fullCube; i++) {
+                fullCube = seen[i];
+            }
+        }
+
+        baked.type = fullCube ? BakedModelType::FULL_CUBE : BakedModelType::MULTI_ELEMENT;
+        if (fullCube) {
+            fullCubeCount++;
+        }
+    }
+
+    // Occupancy mask inputs, indexed like bakedModels_
+    occlusionFlags_.assign(bakedModels_.size(), 0);
+    for (size_t stateId = 0; stateId < bakedModels_.size(); stateId++) {
+        BlockState state(static_cast<uint16_t>(stateId));
+        BakedBlockModel& baked = bakedModels_[stateId];
+        uint8_t flags = 0;
+        if (state.isAir()) {
+            flags |= OCCLUSION_AIR;
+        } else if (cullingSystem_.getBlockShape(state, baked.model).isFullCube()) {
+            flags |= OCCLUSION_OCCLUDER;
+        }
+        if (baked.type == BakedModelType::FULL_CUBE) {
+            flags |= OCCLUSION_FULL_CUBE;
+        }
+        occlusionFlags_[stateId] = flags;
+
+        // LOD cells are drawn as one stretched full face per side of the cell's dominant block
+        if (flags & OCCLUSION_OCCLUDER) {
+            bool sides[6] = {};
+            for (const BakedQuad& quad : baked.quads) {
+                if (quad.greedyMergeable && quad.hasCullface && quad.cullface == quad.face) {
+                    sides[FaceUtils::toIndex(quad.face)] = true;
+                }
+            }
+            baked.lodDrawable = std::all_of(std::begin(sides), std::end(sides), [](bool side) { return side; });
+        }
+    }
+
+    lightEngine_.initialize(bakedModels_.size());
+
+    spdlog::info("Baked {} blockstate models ({} full cubes, {} quads, {} unique)",
+                 stateToModel.size(), fullCubeCount, quadCount, quadLibrary_.size());
 }
 
 void ChunkManager::precacheBlockShapes() {
@@ -213,6 +669,57 @@ void ChunkManager::setRenderDistance(int32_t distance) {
     }
 }
 
+void ChunkManager::setGreedyMeshing(bool enabled) {
+    if (greedyMeshing_.exchange(enabled, std::memory_order_relaxed) == enabled) {
+        return;
+    }
+
+    // Existing meshes were built in the other mode
+    std::vector<ChunkPosition> positions = storage_.getAllPositions();
+    for (const auto& pos : positions) {
+        queueChunkRemesh(pos);
+    }
+    spdlog::info("Greedy meshing {}, remeshing {} chunks", enabled ? "enabled" : "disabled", positions.size());
+}
+
+// Chunks past a LOD ring's edge before a meshed chunk switches level
+static constexpr float LOD_HYSTERESIS = 1.5f;
+
+void ChunkManager::setLodRadii(const std::array<int32_t, LOD_LEVEL_COUNT - 1>& radii) {
+    for (size_t i = 0; i < radii.size(); i++) {
+        lodRadii_[i].store(radii[i], std::memory_order_relaxed);
+    }
+}
+
+uint8_t ChunkManager::selectLodLevel(float distance, uint8_t previousLevel) const {
+    int32_t radii[LOD_LEVEL_COUNT - 1];
+    int enabledLevels = 1;
+    for (int i = 0; i < LOD_LEVEL_COUNT - 1; i++) {
+        radii[i] = lodRadii_[i].load(std::memory_order_relaxed);
+        if (radii[i] <= 0 || (i > 0 && radii[i] <= radii[i - 1])) {
+            break;
+        }
+        enabledLevels++;
+    }
+
+    int level = 0;
+    while (level + 1 < enabledLevels && distance > static_cast<float>(radii[level])) {
+        level++;
+    }
+
+    // Keep the previous level until the chunk is well past its ring's edge, so chunks on
+    // a boundary don't remesh back and forth as the camera moves around it
+    if (previousLevel != level && previousLevel < enabledLevels) {
+        float lower = previousLevel > 0 ? static_cast<float>(radii[previousLevel - 1]) - LOD_HYSTERESIS : -1.0f;
+        float upper = previousLevel + 1 < enabledLevels ? static_cast<float>(radii[previousLevel]) + LOD_HYSTERESIS
+                                                        : std::numeric_limits<float>::max();
+        if (distance >= lower && distance <= upper) {
+            return previousLevel;
+        }
+    }
+    return static_cast<uint8_t>(level);
+}
+
 ChunkPosition ChunkManager::worldToChunkPos(const glm::vec3& worldPos) const {
     return {
         static_cast<int32_t>(std::floor(worldPos.x / CHUNK_SIZE)),
@@ -221,7 +728,14 @@ ChunkPosition ChunkManager::worldToChunkPos(const glm::vec3& worldPos) const {
     };
 }
 
-void ChunkManager::update(const glm::vec3& cameraPosition) {
+// Camera moves up to this many chunks (Manhattan) are applied as shell diffs
+static constexpr int32_t MAX_INCREMENTAL_STEPS = 8;
+// Storage shards swept for stray chunks per update() call
+static constexpr size_t SWEEP_SHARDS_PER_UPDATE = 1;
+// Storage shards checked for LOD level changes per update() call
+static constexpr size_t LOD_SWEEP_SHARDS_PER_UPDATE = 1;
+
+void ChunkManager::update(const glm::vec3& cameraPosition, const glm::vec3& viewDirection) {
     ZoneScoped;
     ChunkPosition cameraChunkPos = worldToChunkPos(cameraPosition);
 
@@ -232,15 +746,62 @@ void ChunkManager::update(const glm::vec3& cameraPosition) {
         lastCameraChunkZ_.load(std::memory_order_relaxed)
     };
 
+    // Re-prioritize when the camera turns noticeably (~25 degrees) even without changing chunk
+    bool viewTurned = glm::dot(viewDirection, lastViewDirection_) < 0.9f * glm::length(viewDirection) * glm::length(lastViewDirection_)
+                      || (glm::length(lastViewDirection_) < 1e-3f) != (glm::length(viewDirection) < 1e-3f);
+
     if (cameraChunkPos != lastPos || renderDistanceChanged_.load(std::memory_order_relaxed)) {
-        loadChunksAroundPosition(cameraChunkPos);
-        unloadDistantChunks(cameraChunkPos);
-        // Lock-free write of camera position
+        // Re-prioritize first so stale jobs are dropped and new ones are ordered for this position
+        size_t dropped = scheduler_.updateCamera(cameraChunkPos, viewDirection, renderDistance_);
+        lastViewDirection_ = viewDirection;
+        if (dropped > 0) {
+            spdlog::debug("Dropped {} stale chunk jobs", dropped);
+        }
+
+        // Lock-free write of camera position (before queueing, so workers judge neighbor range against it)
         lastCameraChunkX_.store(cameraChunkPos.x, std::memory_order_relaxed);
         lastCameraChunkY_.store(cameraChunkPos.y, std::memory_order_relaxed);
         lastCameraChunkZ_.store(cameraChunkPos.z, std::memory_order_relaxed);
+
+        // Short moves only touch the shell that entered/left; the first update,
+        // render distance changes and teleports rebuild from the full sphere
+        bool incremental = loadShell_ && loadShell_->getRadius() == renderDistance_ && lastPos.x != INT32_MAX;
+        if (incremental) {
+            glm::ivec3 moved(cameraChunkPos.x - lastPos.x, cameraChunkPos.y - lastPos.y, cameraChunkPos.z - lastPos.z);
+            incremental = std::abs(moved.x) + std::abs(moved.y) + std::abs(moved.z) <= MAX_INCREMENTAL_STEPS;
+        }
+
+        if (incremental) {
+            updateLoadedShell(lastPos, cameraChunkPos);
+        } else {
+            if (!loadShell_ || loadShell_->getRadius() != renderDistance_) {
+                loadShell_ = std::make_unique<ChunkShellTables>(renderDistance_);
+                unloadShell_ = std::make_unique<ChunkShellTables>(renderDistance_ + 1);
+            }
+            loadChunksAroundPosition(cameraChunkPos);
+            unloadDistantChunks(cameraChunkPos);
+        }
+
+        // Columns follow the unload radius horizontally; vertical moves keep them all
+        if (cameraChunkPos.x != lastPos.x || cameraChunkPos.z != lastPos.z ||
+            renderDistanceChanged_.load(std::memory_order_relaxed)) {
+            terrainGenerator_->evictOutside(cameraChunkPos.x, cameraChunkPos.z, static_cast<float>(renderDistance_ + 1));
+        }
+
+        // Light is kept for exactly the loaded chunks
+        lightEngine_.evictOutside(cameraChunkPos, static_cast<float>(renderDistance_ + 1));
+
         renderDistanceChanged_.store(false, std::memory_order_relaxed);
+
+        // Parked jobs may wait on neighbors that just left render distance; let them re-check
+        resubmitParked(dependencies_.releaseAll());
+    } else if (viewTurned) {
+        scheduler_.updateCamera(cameraChunkPos, viewDirection, renderDistance_);
+        lastViewDirection_ = viewDirection;
     }
+
+    sweepDistantChunks(cameraChunkPos);
+    sweepLodLevels(cameraChunkPos);
 }
 
 void ChunkManager::loadChunksAroundPosition(const ChunkPosition& centerPos) {
@@ -248,58 +809,160 @@ void ChunkManager::loadChunksAroundPosition(const ChunkPosition& centerPos) {
 
     std::vector<MeshWorkItem> chunksToGenerate;
 
-    for (int32_t x = -renderDistance_; x <= renderDistance_; x++) {
-        for (int32_t y = -renderDistance_; y <= renderDistance_; y++) {
-            for (int32_t z = -renderDistance_; z <= renderDistance_; z++) {
-                ChunkPosition pos = {
-                    centerPos.x + x,
-                    centerPos.y + y,
-                    centerPos.z + z
-                };
+    // Sorted offsets: nearest chunks are submitted first
+    for (const glm::ivec3& offset : loadShell_->getBallOffsets()) {
+        ChunkPosition pos = centerPos.getNeighbor(offset.x, offset.y, offset.z);
+        if (!storage_.contains(pos)) {
+            chunksToGenerate.push_back({pos, true});
+        }
+    }
 
-                float distance = std::sqrt(static_cast<float>(x*x + y*y + z*z));
-                if (distance <= renderDistance_) {
-                    if (!storage_.contains(pos)) {
-                        chunksToGenerate.push_back({pos, true});
-                    }
+    // Queue all chunks for generation (the scheduler orders them nearest/in-view first)
+    if (!chunksToGenerate.empty()) {
+        size_t queued = scheduler_.submitBatch(chunksToGenerate);
+        spdlog::trace("Queued {} chunks for generation", queued);
+    }
+}
+
+void ChunkManager::updateLoadedShell(const ChunkPosition& from, const ChunkPosition& to) {
+    ZoneScoped;
+
+    std::vector<MeshWorkItem> entering;
+    std::vector<ChunkPosition> leaving;
+    const glm::ivec3 target(to.x, to.y, to.z);
+
+    // Walk axis by axis in unit steps; candidates are re-checked against the
+    // final center so multi-step moves don't load chunks that already left again
+    glm::ivec3 current(from.x, from.y, from.z);
+    for (int axis = 0; axis < 3; axis++) {
+        while (current[axis] != target[axis]) {
+            glm::ivec3 step(0);
+            step[axis] = target[axis] > current[axis] ? 1 : -1;
+            size_t dir = static_cast<size_t>(ChunkShellTables::getDirectionIndex(step));
+            glm::ivec3 next = current + step;
+
+            for (const glm::ivec3& offset : loadShell_->getEnteringOffsets(dir)) {
+                glm::ivec3 pos = next + offset;
+                if (loadShell_->isInside(pos - target) && !storage_.contains({pos.x, pos.y, pos.z})) {
+                    entering.push_back({{pos.x, pos.y, pos.z}, true});
+                }
+            }
+            for (const glm::ivec3& offset : unloadShell_->getLeavingOffsets(dir)) {
+                glm::ivec3 pos = current + offset;
+                if (!unloadShell_->isInside(pos - target)) {
+                    leaving.push_back({pos.x, pos.y, pos.z});
                 }
             }
+
+            current = next;
         }
     }
 
-    // Queue all chunks for generation
-    if (!chunksToGenerate.empty()) {
-        std::lock_guard<std::mutex> lock(workQueueMutex_);
-        for (const auto& item : chunksToGenerate) {
-            workQueue_.push(item);
-        }
-        workQueueCV_.notify_all();
-        spdlog::trace("Queued {} chunks for generation", chunksToGenerate.size());
+    if (!entering.empty()) {
+        size_t queued = scheduler_.submitBatch(entering);
+        spdlog::trace("Queued {} entering chunks for generation", queued);
+    }
+
+    std::vector<ChunkDataPtr> removedChunks;
+    size_t removed = storage_.removeAll(leaving, regionStorage_.isOpen() ? &removedChunks : nullptr);
+    saveRemovedChunks(removedChunks);
+    if (removed > 0) {
+        spdlog::debug("Unloaded {} chunks", removed);
     }
 }
 
 void ChunkManager::unloadDistantChunks(const ChunkPosition& centerPos) {
     ZoneScoped;
 
-    size_t removed = storage_.removeOutsideRadius(centerPos, static_cast<float>(renderDistance_ + 1));
+    std::vector<ChunkDataPtr> removedChunks;
+    size_t removed = storage_.removeOutsideRadius(centerPos, static_cast<float>(renderDistance_ + 1),
+                                                  regionStorage_.isOpen() ? &removedChunks : nullptr);
+    saveRemovedChunks(removedChunks);
     if (removed > 0) {
         spdlog::debug("Unloaded {} chunks", removed);
     }
 }
 
+void ChunkManager::sweepDistantChunks(const ChunkPosition& centerPos) {
+    ZoneScoped;
+
+    // Catches chunks the shell diff can't see (e.g. generated by a job that was
+    // already running when the camera moved away), one shard slice per update
+    std::vector<ChunkDataPtr> removedChunks;
+    size_t removed = storage_.removeOutsideRadius(centerPos, static_cast<float>(renderDistance_ + 1),
+                                                  regionStorage_.isOpen() ? &removedChunks : nullptr,
+                                                  unloadSweepShard_, SWEEP_SHARDS_PER_UPDATE);
+    unloadSweepShard_ = (unloadSweepShard_ + SWEEP_SHARDS_PER_UPDATE) % ChunkStorage::NUM_SHARDS;
+    saveRemovedChunks(removedChunks);
+    if (removed > 0) {
+        spdlog::debug("Swept {} stray chunks", removed);
+    }
+}
+
+void ChunkManager::sweepLodLevels(const ChunkPosition& centerPos) {
+    ZoneScoped;
+
+    // Levels follow the camera with up to NUM_SHARDS updates of delay, at a bounded cost per update
+    std::vector<MeshWorkItem> items;
+    storage_.forEachInShards(lodSweepShard_, LOD_SWEEP_SHARDS_PER_UPDATE,
+                             [&](const ChunkPosition& pos, const ChunkDataPtr& chunk) {
+        if (chunk->isEmpty() || chunk->isMeshDirty()) {
+            return;  // Nothing to draw, or a pending job picks the level anyway
+        }
+        uint8_t current = chunk->getMeshLod();
+        if (selectLodLevel(pos.distanceTo(centerPos), current) != current && chunk->markMeshDirty()) {
+            items.push_back({pos, false});
+        }
+    });
+    lodSweepShard_ = (lodSweepShard_ + LOD_SWEEP_SHARDS_PER_UPDATE) % ChunkStorage::NUM_SHARDS;
+
+    if (!items.empty()) {
+        scheduler_.submitBatch(items);
+        spdlog::trace("Queued {} chunks for an LOD change", items.size());
+    }
+}
+
+void ChunkManager::saveRemovedChunks(const std::vector<ChunkDataPtr>& removed) {
+    for (const auto& chunk : removed) {
+        saveChunkIfModified(chunk);
+    }
+}
+
+void ChunkManager::saveChunkIfModified(const ChunkDataPtr& chunk) {
+    // Version 0 means unedited since it was generated or loaded; only the
+    // generated ones are missing from disk, which the I/O thread checks
+    regionStorage_.save(chunk, chunk->getVersion() == 0);
+}
+
+bool ChunkManager::openWorld(const std::filesystem::path& directory) {
+    return regionStorage_.open(directory);
+}
+
+void ChunkManager::saveAllChunks() {
+    ZoneScoped;
+
+    if (!regionStorage_.isOpen()) {
+        return;
+    }
+
+    storage_.forEach([this](const ChunkPosition&, const ChunkDataPtr& chunk) {
+        saveChunkIfModified(chunk);
+    });
+}
+
 void ChunkManager::clearAllChunks() {
     ZoneScoped;
 
+    // Keep edits from being lost with the in-memory chunks
+    saveAllChunks();
+
     size_t count = storage_.size();
     storage_.clear();
+    terrainGenerator_->clearCache();
+    lightEngine_.clear();
 
     // Clear work queue
-    {
-        std::lock_guard<std::mutex> lock(workQueueMutex_);
-        while (!workQueue_.empty()) {
-            workQueue_.pop();
-        }
-    }
+    scheduler_.clear();
 
     // Clear ready meshes
     {
@@ -309,11 +972,7 @@ void ChunkManager::clearAllChunks() {
         }
     }
 
-    // Clear dirty tracking
-    {
-        std::lock_guard<std::mutex> lock(dirtyMutex_);
-        dirtyChunks_.clear();
-    }
+    dependencies_.clear();
 
     // Reset camera position atomically
     lastCameraChunkX_.store(INT32_MAX, std::memory_order_relaxed);
@@ -357,41 +1016,97 @@ BlockState ChunkManager::getBlockState(const glm::ivec3& worldPos) const {
 void ChunkManager::setBlockState(const glm::ivec3& worldPos, BlockState state) {
     ZoneScoped;
 
-    ChunkPosition chunkPos = worldToChunkPos(glm::vec3(worldPos));
+    ChunkEditBatch batch(*this);
+    batch.setBlockState(worldPos, state);
+    applyEdits(batch);
+}
+
+size_t ChunkManager::applyEdits(const ChunkEditBatch& batch) {
+    ZoneScoped;
+
+    std::unordered_set<ChunkPosition, ChunkPositionHash> remeshSet;
+    size_t rewritten = 0;
 
-    ChunkDataPtr oldChunk = storage_.get(chunkPos);
-    if (!oldChunk) {
-        return;  // Can't set block in non-existent chunk
+    for (const auto& [chunkPos, chunkEdits] : batch.getChunkEdits()) {
+        ChunkDataPtr oldChunk = storage_.get(chunkPos);
+        if (!oldChunk) {
+            continue;  // Can't set blocks in non-existent chunk
+        }
+
+        // Copy-on-write once for all edits in this chunk, then atomic swap
+        storage_.insert(chunkPos, oldChunk->withBlockStates(chunkEdits.toEdits()));
+        rewritten++;
+
+        remeshSet.insert(chunkPos);
+
+        // Also remesh neighbors across boundaries that had edits
+        const auto offsets = ChunkPosition::getFaceNeighborOffsets();
+        for (size_t face = 0; face < offsets.size(); face++) {
+            if (chunkEdits.touchedFaces & (1 << face)) {
+                remeshSet.insert(chunkPos.getNeighbor(offsets[face].x, offsets[face].y, offsets[face].z));
+            }
+        }
     }
 
-    glm::ivec3 localPos = worldPos - glm::ivec3(
-        chunkPos.x * static_cast<int32_t>(CHUNK_SIZE),
-        chunkPos.y * static_cast<int32_t>(CHUNK_SIZE),
-        chunkPos.z * static_cast<int32_t>(CHUNK_SIZE)
-    );
+    std::vector<MeshWorkItem> items;
+    items.reserve(remeshSet.size());
+    for (const auto& pos : remeshSet) {
+        if (storage_.contains(pos)) {
+            markDirty(pos);
+            items.push_back({pos, false});
+        }
+    }
+    if (!items.empty()) {
+        scheduler_.submitBatch(items);
+    }
 
-    if (localPos.x < 0 || localPos.x >= static_cast<int32_t>(CHUNK_SIZE) ||
-        localPos.y < 0 || localPos.y >= static_cast<int32_t>(CHUNK_SIZE) ||
-        localPos.z < 0 || localPos.z >= static_cast<int32_t>(CHUNK_SIZE)) {
-        return;
+    return rewritten;
+}
+
+size_t ChunkManager::fillRegion(const glm::ivec3& min, const glm::ivec3& max, BlockState state) {
+    ZoneScoped;
+
+    ChunkEditBatch batch(*this);
+    for (int32_t z = min.z; z <= max.z; z++) {
+        for (int32_t y = min.y; y <= max.y; y++) {
+            for (int32_t x = min.x; x <= max.x; x++) {
+                batch.setBlockState({x, y, z}, state);
+            }
+        }
     }
+    return applyEdits(batch);
+}
 
-    // Copy-on-write: create new chunk with modification
-    ChunkDataPtr newChunk = oldChunk->withBlockState(localPos.x, localPos.y, localPos.z, state);
+size_t ChunkManager::replaceRegion(const glm::ivec3& min, const glm::ivec3& max, BlockState from, BlockState to) {
+    ZoneScoped;
 
-    // Atomic swap
-    storage_.insert(chunkPos, newChunk);
+    ChunkEditBatch batch(*this);
+    for (int32_t z = min.z; z <= max.z; z++) {
+        for (int32_t y = min.y; y <= max.y; y++) {
+            for (int32_t x = min.x; x <= max.x; x++) {
+                if (getBlockState({x, y, z}) == from) {
+                    batch.setBlockState({x, y, z}, to);
+                }
+            }
+        }
+    }
+    return applyEdits(batch);
+}
 
-    // Mark for remeshing
-    queueChunkRemesh(chunkPos);
+size_t ChunkManager::copyRegion(const glm::ivec3& srcMin, const glm::ivec3& srcMax, const glm::ivec3& dstMin) {
+    ZoneScoped;
 
-    // Also remesh neighbors if block is on chunk boundary
-    if (localPos.x == 0) queueChunkRemesh({chunkPos.x - 1, chunkPos.y, chunkPos.z});
-    if (localPos.x == static_cast<int32_t>(CHUNK_SIZE) - 1) queueChunkRemesh({chunkPos.x + 1, chunkPos.y, chunkPos.z});
-    if (localPos.y == 0) queueChunkRemesh({chunkPos.x, chunkPos.y - 1, chunkPos.z});
-    if (localPos.y == static_cast<int32_t>(CHUNK_SIZE) - 1) queueChunkRemesh({chunkPos.x, chunkPos.y + 1, chunkPos.z});
-    if (localPos.z == 0) queueChunkRemesh({chunkPos.x, chunkPos.y, chunkPos.z - 1});
-    if (localPos.z == static_cast<int32_t>(CHUNK_SIZE) - 1) queueChunkRemesh({chunkPos.x, chunkPos.y, chunkPos.z + 1});
+    // Reads come from the committed world, so overlapping source/destination copy correctly
+    ChunkEditBatch batch(*this);
+    for (int32_t z = srcMin.z; z <= srcMax.z; z++) {
+        for (int32_t y = srcMin.y; y <= srcMax.y; y++) {
+            for (int32_t x = srcMin.x; x <= srcMax.x; x++) {
+                glm::ivec3 srcPos(x, y, z);
+                batch.setBlockState(dstMin + (srcPos - srcMin), getBlockState(srcPos));
+            }
+        }
+    }
+    return applyEdits(batch);
 }
 
 void ChunkManager::meshWorker(unsigned int threadId) {
@@ -399,26 +1114,10 @@ void ChunkManager::meshWorker(unsigned int threadId) {
     std::string threadName = "MeshWorker " + std::to_string(threadId);
     tracy::SetThreadName(threadName.c_str());
 
-    while (running_) {
-        MeshWorkItem workItem;
-
-        // PHASE 1: Grab work item (minimal lock time)
-        {
-            std::unique_lock<std::mutex> lock(workQueueMutex_);
-            workQueueCV_.wait(lock, [this] { return !workQueue_.empty() || !running_; });
-
-            if (!running_) {
-                break;
-            }
+    MeshWorkItem workItem;
 
-            if (workQueue_.empty()) {
-                continue;
-            }
-
-            workItem = workQueue_.front();
-            workQueue_.pop();
-        }
-        // Lock released - other workers can grab work NOW
+    // PHASE 1: Grab the highest-priority job (own heap first, then steal)
+    while (scheduler_.waitAndPop(threadId, workItem)) {
 
         const ChunkPosition& pos = workItem.position;
 
@@ -426,71 +1125,144 @@ void ChunkManager::meshWorker(unsigned int threadId) {
         ChunkDataPtr chunkData = storage_.get(pos);
 
         bool needsGeneration = !chunkData;
-        bool needsMeshing = isDirty(pos);
+        bool needsMeshing = !needsGeneration && chunkData->isMeshDirty();
+        bool needsLight = needsGeneration || lightEngine_.needsUpdate(pos, chunkData->getVersion());
 
-        if (!needsGeneration && !needsMeshing) {
+        if (!needsGeneration && !needsMeshing && !needsLight) {
             continue;  // Nothing to do
         }
 
-        // PHASE 3: Generate chunk if needed (NO LOCKS HELD)
+        // PHASE 3: Load or generate chunk if needed (NO LOCKS HELD)
         if (needsGeneration) {
             ZoneScopedN("Generate Chunk");
-            chunkData = ChunkData::generate(pos);
+            chunkData = regionStorage_.load(pos);
+            if (chunkData) {
+                spdlog::trace("Worker {} loaded chunk at ({}, {}, {})", threadId, pos.x, pos.y, pos.z);
+            } else {
+                chunkData = terrainGenerator_->generate(pos);
+                spdlog::trace("Worker {} generated chunk at ({}, {}, {})", threadId, pos.x, pos.y, pos.z);
+            }
             storage_.insert(pos, chunkData);
-            markDirty(pos);
-            needsMeshing = true;
+            // Light kept from an earlier load may match this version number but not these blocks
+            lightEngine_.markStale(pos);
+            needsMeshing = true;  // New ChunkData starts mesh-dirty
 
-            spdlog::trace("Worker {} generated chunk at ({}, {}, {})", threadId, pos.x, pos.y, pos.z);
+            // Wake chunks waiting on this one; neighbors meshed while it was out of range need its border
+            completeStage(pos, ChunkStage::Generated);
+            queueNeighborRemesh(pos);
+        }
+
+        // PHASE 4: Park until the neighbors are generated (their completeStage() resubmits this job)
+        if (waitForNeighbors(pos, ChunkStage::Generated)) {
+            continue;
         }
 
-        // PHASE 4: Check if neighbors are ready for meshing
-        if (needsMeshing) {
-            if (!areNeighborsLoadedForMeshing(pos)) {
-                // Re-queue for later
-                std::lock_guard<std::mutex> lock(workQueueMutex_);
-                workQueue_.push({pos, false});
+        // PHASE 5: Relight from a snapshot of chunk + neighbors (BRIEF lock per shard),
+        // then pass border changes on to the neighbors that read them
+        if (needsLight) {
+            ZoneScopedN("Propagate Light");
+            ChunkNeighborhood neighborhood = storage_.getWithNeighbors(pos);
+            if (!neighborhood.getCenter()) {
+                continue;  // Chunk was unloaded
+            }
+
+            LightEngine::UpdateResult lightResult = lightEngine_.update(neighborhood);
+            completeStage(pos, ChunkStage::Lit);
+
+            std::vector<MeshWorkItem> affected;
+            for (int dz = -1; dz <= 1; dz++) {
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        uint32_t bit = 1u << ChunkNeighborhood::getIndex(dx, dy, dz);
+                        if (!(lightResult.changedNeighbors & bit) || !neighborhood.get(dx, dy, dz)) {
+                            continue;
+                        }
+                        ChunkPosition neighborPos = pos.getNeighbor(dx, dy, dz);
+                        if (lightResult.relightNeighbors & bit) {
+                            lightEngine_.markStale(neighborPos);
+                        }
+                        markDirty(neighborPos);
+                        affected.push_back({neighborPos, false});
+                    }
+                }
+            }
+            if (!affected.empty()) {
+                scheduler_.submitBatch(affected);
+            }
+
+            if (lightResult.stillStale) {
+                // A neighbor changed while we computed; mesh after the next pass
+                scheduler_.submit({pos, workItem.isNewChunk});
                 continue;
             }
+            if (lightResult.lightChanged) {
+                markDirty(pos);
+                needsMeshing = true;
+            }
         }
 
-        // PHASE 5: Grab snapshot of chunk + neighbors (BRIEF lock per shard)
-        // After this, we hold shared_ptrs - completely safe to use without locks
-        std::array<ChunkDataPtr, 7> chunkWithNeighbors = storage_.getWithNeighbors(pos);
-        ChunkDataPtr centerChunk = chunkWithNeighbors[0];
+        if (!needsMeshing) {
+            continue;
+        }
 
+        // Meshing with assumed neighbor light would only be redone once it arrives
+        if (waitForNeighbors(pos, ChunkStage::Lit)) {
+            continue;
+        }
+
+        // PHASE 6: Claim the mesh, then snapshot blocks and light (BRIEF lock per shard).
+        // The dirty flag is cleared and the sequence taken BEFORE the snapshot, so any edit,
+        // neighbor change or relight landing after them marks the chunk again and queues a
+        // mesh with a higher sequence. Several marks since the last mesh collapse into this
+        // single job; the scheduler already keeps at most one queued entry per position.
+        ChunkDataPtr centerChunk = storage_.get(pos);
         if (!centerChunk) {
             continue;  // Chunk was unloaded
         }
+        if (!centerChunk->takeMeshDirty()) {
+            continue;  // Another worker meshed it since this job was queued
+        }
+        uint64_t sequence = meshSequence_.fetch_add(1, std::memory_order_relaxed) + 1;
 
-        // Clear dirty flag BEFORE meshing (allows new dirty marks during mesh)
-        clearDirty(pos);
+        // After this, we hold shared_ptrs - completely safe to use without locks
+        ChunkNeighborhood neighborhood = storage_.getWithNeighbors(pos);
+        if (neighborhood.getCenter() != centerChunk) {
+            continue;  // Replaced or unloaded since the claim; new data starts dirty with its own job
+        }
+        ChunkLightNeighborhood light = lightEngine_.getNeighborhood(pos);
 
-        // PHASE 6: Generate mesh - ZERO LOCKS HELD - FULL PARALLELISM
+        // PHASE 7: Generate mesh - ZERO LOCKS HELD - FULL PARALLELISM
         CompactChunkMesh mesh;
         if (!centerChunk->isEmpty()) {
             ZoneScopedN("Generate Mesh");
-            mesh = generateChunkMesh(centerChunk, chunkWithNeighbors);
+            ChunkPosition cameraChunk{lastCameraChunkX_.load(std::memory_order_relaxed),
+                                      lastCameraChunkY_.load(std::memory_order_relaxed),
+                                      lastCameraChunkZ_.load(std::memory_order_relaxed)};
+            uint8_t lodLevel = selectLodLevel(pos.distanceTo(cameraChunk), centerChunk->getMeshLod());
+            centerChunk->setMeshLod(lodLevel);
+
+            mesh = lodLevel > 0 ? generateLodMesh(neighborhood, lodLevel, &light)
+                                : generateChunkMesh(neighborhood, &light);
         } else {
             mesh.position = pos;
         }
+        mesh.version = centerChunk->getVersion();
+        mesh.sequence = sequence;
 
-        // PHASE 7: Push mesh to ready queue
+        // PHASE 8: Push mesh to ready queue
         {
             std::lock_guard<std::mutex> lock(readyMutex_);
             readyMeshes_.push(std::move(mesh));
         }
-
-        // PHASE 8: Queue neighbor remesh if this was a new chunk
-        if (workItem.isNewChunk) {
-            queueNeighborRemesh(pos);
-        }
     }
 }
 
-CompactChunkMesh ChunkManager::generateChunkMesh(ChunkDataPtr chunk,
-                                                  const std::array<ChunkDataPtr, 7>& neighbors) const {
+CompactChunkMesh ChunkManager::generateChunkMesh(const ChunkNeighborhood& chunks,
+                                                  const ChunkLightNeighborhood* light) const {
     ZoneScoped;
 
+    const ChunkDataPtr& chunk = chunks.getCenter();
+
     CompactChunkMesh mesh;
     mesh.position = chunk->getPosition();
 
@@ -498,161 +1270,407 @@ CompactChunkMesh ChunkManager::generateChunkMesh(ChunkDataPtr chunk,
         return mesh;
     }
 
-    const ChunkPosition& chunkPos = chunk->getPosition();
+    // Greedy mode collects mergeable faces into per-direction slice masks and emits them at the end
+    const bool greedy = greedyMeshing_.load(std::memory_order_relaxed);
+    std::vector<uint32_t>& greedyMask = getGreedyMask();
+
+    // Input stage: resolve the chunk and its border once; every block and
+    // neighbor read below is an indexed load
+    thread_local PaddedChunkSnapshot snapshot;
+    snapshot.build(chunks);
+
+    int faceSteps[6];
+    for (int faceIndex = 0; faceIndex < 6; faceIndex++) {
+        faceSteps[faceIndex] = PaddedChunkSnapshot::getFaceStep(faceIndex);
+    }
+
+    FaceBuckets& buckets = getFaceBuckets();
 
-    // Lambda to get neighbor block state (uses captured neighbor pointers)
-    auto getNeighborBlockState = [&](int nx, int ny, int nz) -> BlockState {
-        if (nx >= 0 && nx < static_cast<int>(CHUNK_SIZE) &&
-            ny >= 0 && ny < static_cast<int>(CHUNK_SIZE) &&
-            nz >= 0 && nz < static_cast<int>(CHUNK_SIZE)) {
-            return chunk->getBlockState(nx, ny, nz);
+    // Per-corner light is deduplicated into the mesh's lighting table
+    thread_local std::unordered_map<PackedLighting, uint32_t, PackedLightingHash> lightIndices;
+    lightIndices.clear();
+    auto getLightIndex = [&](const PackedLighting& lighting) -> uint32_t {
+        auto [it, inserted] = lightIndices.try_emplace(lighting, static_cast<uint32_t>(mesh.lighting.size()));
+        if (inserted) {
+            mesh.lighting.push_back(lighting);
         }
+        return it->second;
+    };
 
-        // Determine which neighbor chunk
-        int neighborIdx = -1;
-        int localX = nx, localY = ny, localZ = nz;
+    thread_local std::array<uint8_t, PaddedChunkSnapshot::VOLUME> paddedLight;
+    thread_local std::array<uint8_t, PaddedChunkSnapshot::VOLUME> paddedOpaque;
+    if (light) {
+        buildPaddedLight(*light, paddedLight.data(), paddedOpaque.data());
+    } else {
+        paddedOpaque.fill(0);
+    }
 
-        if (nx < 0) { neighborIdx = 1; localX = CHUNK_SIZE - 1; }  // West
-        else if (nx >= static_cast<int>(CHUNK_SIZE)) { neighborIdx = 2; localX = 0; }  // East
-        else if (ny < 0) { neighborIdx = 3; localY = CHUNK_SIZE - 1; }  // Down
-        else if (ny >= static_cast<int>(CHUNK_SIZE)) { neighborIdx = 4; localY = 0; }  // Up
-        else if (nz < 0) { neighborIdx = 5; localZ = CHUNK_SIZE - 1; }  // North
-        else if (nz >= static_cast<int>(CHUNK_SIZE)) { neighborIdx = 6; localZ = 0; }  // South
+    // Ambient occlusion occluders, resolved once from the snapshot
+    thread_local std::array<uint8_t, PaddedChunkSnapshot::VOLUME> aoOccluders;
+    for (int i = 0; i < PaddedChunkSnapshot::VOLUME; i++) {
+        uint16_t stateId = snapshot.states[i];
+        aoOccluders[i] = stateId < occlusionFlags_.size() && (occlusionFlags_[stateId] & OCCLUSION_OCCLUDER) ? 1 : 0;
+    }
 
-        if (neighborIdx > 0 && neighbors[neighborIdx]) {
-            return neighbors[neighborIdx]->getBlockState(localX, localY, localZ);
+    auto computeQuadLighting = [&](const BakedQuad& quad, int cell) -> PackedLighting {
+        int faceIndex = FaceUtils::toIndex(quad.face);
+        int uAxis, vAxis, layerAxis;
+        getGreedyAxes(quad.face, uAxis, vAxis, layerAxis);
+
+        // Faces on the block boundary (and any face of a light-blocking block) take the
+        // light in front of them; inset faces share the block's own cell
+        int base = cell;
+        if (quad.hasCullface || paddedOpaque[cell]) {
+            base += faceSteps[faceIndex];
         }
 
-        return BlockRegistry::AIR->getDefaultState();
+        PackedLighting lighting;
+        for (int i = 0; i < 4; i++) {
+            int uStride = PaddedChunkSnapshot::STRIDES[uAxis];
+            int vStride = PaddedChunkSnapshot::STRIDES[vAxis];
+            int uStep = (quad.cornerSides[i] & 1) ? uStride : -uStride;
+            int vStep = (quad.cornerSides[i] & 2) ? vStride : -vStride;
+            lighting.corners[i] = computeCornerLight(light ? paddedLight.data() : nullptr, paddedOpaque.data(),
+                                                     aoOccluders.data(), base, uStep, vStep, quad.tinted);
+        }
+        return lighting;
     };
 
-    // Iterate through all blocks
-    for (uint32_t bx = 0; bx < CHUNK_SIZE; bx++) {
+    // Occupancy masks decide every face against air or a full-cube occluder,
+    // 16 blocks at a time; only partial-shape neighbors reach the culling table
+    ChunkOccupancy occupancy;
+    occupancy.build(snapshot, occlusionFlags_);
+    mesh.connectivity = occupancy.computeFaceConnectivity();
+
+    for (uint32_t bz = 0; bz < CHUNK_SIZE; bz++) {
         for (uint32_t by = 0; by < CHUNK_SIZE; by++) {
-            for (uint32_t bz = 0; bz < CHUNK_SIZE; bz++) {
-                BlockState state = chunk->getBlockState(bx, by, bz);
-                if (state.isAir()) {
+            int32_t y = static_cast<int32_t>(by);
+            int32_t z = static_cast<int32_t>(bz);
+
+            uint32_t solidRow = ~occupancy.air[ChunkOccupancy::getRowIndex(y, z)] & ChunkOccupancy::INTERIOR_BITS;
+            if (solidRow == 0) {
+                continue;
+            }
+
+            uint32_t airRows[6];
+            uint32_t occluderRows[6];
+            uint32_t exposedRow = 0;
+            for (int faceIndex = 0; faceIndex < 6; faceIndex++) {
+                airRows[faceIndex] = ChunkOccupancy::getNeighborRow(occupancy.air, faceIndex, y, z);
+                occluderRows[faceIndex] = ChunkOccupancy::getNeighborRow(occupancy.occluder, faceIndex, y, z);
+                exposedRow |= ~occluderRows[faceIndex];
+            }
+
+            // Full cubes with an occluder on all six sides have nothing to draw
+            uint32_t buriedRow = occupancy.getFullCubeRow(by, bz) & ~exposedRow;
+
+            for (uint32_t blockBits = solidRow & ~buriedRow; blockBits != 0; blockBits &= blockBits - 1) {
+                uint32_t bit = static_cast<uint32_t>(std::countr_zero(blockBits));
+                uint32_t bx = bit - 1;
+
+                int cell = PaddedChunkSnapshot::getIndex(static_cast<int>(bx), y, z);
+                BlockState state(snapshot.states[cell]);
+                if (state.id >= bakedModels_.size()) {
                     continue;
                 }
 
-                const BlockStateVariant* variant = modelManager_.getVariantByStateId(state.id);
-                const BlockModel* model = variant ? variant->model : modelManager_.getModelByStateId(state.id);
-
-                if (!model || model->elements.empty()) {
+                const BakedBlockModel& baked = bakedModels_[state.id];
+                if (baked.type == BakedModelType::EMPTY) {
                     continue;
                 }
 
-                int rotationX = variant ? variant->rotationX : 0;
-                int rotationY = variant ? variant->rotationY : 0;
+                // Cull decisions are per direction, shared by all quads culling against it.
+                // Air neighbors always draw and occluders always cull; -1 = ask shouldDrawFace
+                int8_t drawFace[6];
+                for (int faceIndex = 0; faceIndex < 6; faceIndex++) {
+                    uint32_t mask = 1u << bit;
+                    drawFace[faceIndex] = (occluderRows[faceIndex] & mask) ? 0
+                                        : (airRows[faceIndex] & mask) ? 1 : -1;
+                }
 
-                for (const auto& element : model->elements) {
-                    glm::vec3 elemFrom = element.from / 16.0f;
-                    glm::vec3 elemTo = element.to / 16.0f;
+                const BlockShape* currentShape = nullptr;
+                auto isFaceVisible = [&](FaceDirection cullface) -> bool {
+                    int faceIndex = FaceUtils::toIndex(cullface);
+                    if (drawFace[faceIndex] < 0) {
+                        BlockState neighborState(snapshot.states[cell + faceSteps[faceIndex]]);
 
-                    if (rotationY != 0) {
-                        elemFrom = applyYRotation(elemFrom, rotationY);
-                        elemTo = applyYRotation(elemTo, rotationY);
-                    }
-                    if (rotationX != 0) {
-                        elemFrom = applyXRotation(elemFrom, rotationX);
-                        elemTo = applyXRotation(elemTo, rotationX);
+                        if (cullingSystem_.hasDrawTableEntry(state, neighborState)) {
+                            drawFace[faceIndex] = cullingSystem_.lookupDrawFace(state, neighborState, cullface) ? 1 : 0;
+                            return drawFace[faceIndex] != 0;
+                        }
+
+                        if (!currentShape) {
+                            currentShape = &cullingSystem_.getBlockShape(state, baked.model);
+                        }
+                        const BlockModel* neighborModel = neighborState.id < bakedModels_.size()
+                            ? bakedModels_[neighborState.id].model : nullptr;
+                        const BlockShape& neighborShape = cullingSystem_.getBlockShape(neighborState, neighborModel);
+
+                        drawFace[faceIndex] = cullingSystem_.shouldDrawFace(
+                            state, neighborState, cullface, *currentShape, neighborShape) ? 1 : 0;
                     }
+                    return drawFace[faceIndex] != 0;
+                };
 
-                    glm::vec3 finalFrom = glm::min(elemFrom, elemTo);
-                    glm::vec3 finalTo = glm::max(elemFrom, elemTo);
+                for (const BakedQuad& quad : baked.quads) {
+                    if (quad.hasCullface && !isFaceVisible(quad.cullface)) {
+                        continue;
+                    }
 
-                    for (const auto& [faceDir, face] : element.faces) {
-                        FaceDirection rotatedFaceDir = faceDir;
-                        if (rotationY != 0) {
-                            rotatedFaceDir = rotateYFace(rotatedFaceDir, rotationY);
-                        }
-                        if (rotationX != 0) {
-                            rotatedFaceDir = rotateXFace(rotatedFaceDir, rotationX);
+                    PackedLighting lighting = computeQuadLighting(quad, cell);
+                    uint32_t lightIndex = getLightIndex(lighting);
+
+                    // Merged faces stretch one lighting entry, so only evenly lit faces can merge
+                    bool evenlyLit = lighting.corners[0] == lighting.corners[1] &&
+                                     lighting.corners[0] == lighting.corners[2] &&
+                                     lighting.corners[0] == lighting.corners[3];
+                    if (greedy && quad.greedyMergeable && evenlyLit) {
+                        uint32_t& maskCell = greedyMask[getGreedyCellIndex(quad.face, bx, by, bz)];
+                        // A second full face in the same cell (e.g. overlays) is emitted unmerged
+                        if (maskCell == GREEDY_EMPTY) {
+                            maskCell = ((lightIndex & 0xFFFF) << 16) | quad.quadIndex;
+                            continue;
                         }
+                    }
 
-                        bool shouldRender = true;
+                    buckets[quad.bucket].push_back(FaceData::pack(bx, by, bz, false, lightIndex, quad.quadIndex,
+                                                                  1, 1, shouldFlipDiagonal(lighting)));
+                    mesh.growBounds(glm::ivec3(bx, by, bz), glm::ivec3(bx + 1, by + 1, bz + 1));
+                }
+            }
+        }
+    }
 
-                        if (face.cullface.has_value()) {
-                            FaceDirection rotatedCullface = face.cullface.value();
-                            if (rotationY != 0) {
-                                rotatedCullface = rotateYFace(rotatedCullface, rotationY);
-                            }
-                            if (rotationX != 0) {
-                                rotatedCullface = rotateXFace(rotatedCullface, rotationX);
-                            }
+    if (greedy) {
+        emitGreedyFaces(greedyMask, mesh, buckets);
+    }
+    appendFaceBuckets(buckets, mesh);
 
-                            if (FaceUtils::faceReachesBoundary(rotatedCullface, elemFrom, elemTo)) {
-                                int faceIndex = FaceUtils::toIndex(rotatedCullface);
-                                int nx = bx + FaceUtils::FACE_DIRS[faceIndex][0];
-                                int ny = by + FaceUtils::FACE_DIRS[faceIndex][1];
-                                int nz = bz + FaceUtils::FACE_DIRS[faceIndex][2];
+    return mesh;
+}
 
-                                BlockState neighborState = getNeighborBlockState(nx, ny, nz);
+CompactChunkMesh ChunkManager::generateLodMesh(const ChunkNeighborhood& chunks, int lodLevel,
+                                                const ChunkLightNeighborhood* light) const {
+    ZoneScoped;
 
-                                const BlockShape& currentShape = cullingSystem_.getBlockShape(state, model);
-                                const BlockModel* neighborModel = modelManager_.getModelByStateId(neighborState.id);
-                                const BlockShape& neighborShape = cullingSystem_.getBlockShape(neighborState, neighborModel);
+    const ChunkDataPtr& chunk = chunks.getCenter();
 
-                                bool shouldDrawThisFace = cullingSystem_.shouldDrawFace(
-                                    state, neighborState, rotatedCullface, currentShape, neighborShape);
+    CompactChunkMesh mesh;
+    mesh.position = chunk->getPosition();
 
-                                if (!shouldDrawThisFace) {
-                                    shouldRender = false;
-                                }
+    if (chunk->isEmpty()) {
+        return mesh;
+    }
+
+    const int scale = 1 << lodLevel;
+    const int cells = static_cast<int>(CHUNK_SIZE) / scale;
+
+    thread_local PaddedChunkSnapshot snapshot;
+    snapshot.build(chunks);
+
+    ChunkOccupancy occupancy;
+    occupancy.build(snapshot, occlusionFlags_);
+    mesh.connectivity = occupancy.computeFaceConnectivity();
+
+    auto isOccluder = [&](int index) {
+        uint16_t stateId = snapshot.states[index];
+        return stateId < occlusionFlags_.size() && (occlusionFlags_[stateId] & OCCLUSION_OCCLUDER);
+    };
+    auto addWeight = [](std::vector<std::pair<uint16_t, uint32_t>>& weights, uint16_t stateId, uint32_t weight) {
+        for (auto& [id, total] : weights) {
+            if (id == stateId) {
+                total += weight;
+                return;
+            }
+        }
+        weights.emplace_back(stateId, weight);
+    };
+    auto heaviest = [](const std::vector<std::pair<uint16_t, uint32_t>>& weights) -> uint16_t {
+        auto it = std::max_element(weights.begin(), weights.end(),
+                                   [](const auto& a, const auto& b) { return a.second < b.second; });
+        return it != weights.end() ? it->first : 0;
+    };
+
+    // A cell is filled as soon as it holds one occluder, so the coarse volume contains every solid
+    // block: with border faces culled against the neighbor's real blocks (below), chunks at any two
+    // levels meet without cracks. It is drawn as its dominant block, counting blocks open to the
+    // sky as a whole column so surface blocks win over what lies beneath them.
+    thread_local std::vector<uint8_t> cellFilled;
+    thread_local std::vector<uint16_t> cellStates;  // 0 = no drawable block in the cell
+    thread_local std::vector<std::pair<uint16_t, uint32_t>> weights;
+    thread_local std::vector<std::pair<uint16_t, uint32_t>> chunkWeights;
+    cellFilled.assign(static_cast<size_t>(cells * cells * cells), 0);
+    cellStates.assign(static_cast<size_t>(cells * cells * cells), 0);
+    chunkWeights.clear();
+
+    auto getCellIndex = [cells](const glm::ivec3& cell) { return cell.x + cell.y * cells + cell.z * cells * cells; };
+
+    for (int cz = 0; cz < cells; cz++) {
+        for (int cy = 0; cy < cells; cy++) {
+            for (int cx = 0; cx < cells; cx++) {
+                bool filled = false;
+                weights.clear();
+                for (int z = cz * scale; z < (cz + 1) * scale; z++) {
+                    for (int y = cy * scale; y < (cy + 1) * scale; y++) {
+                        for (int x = cx * scale; x < (cx + 1) * scale; x++) {
+                            int index = PaddedChunkSnapshot::getIndex(x, y, z);
+                            if (!isOccluder(index)) {
+                                continue;
+                            }
+                            filled = true;
+                            uint16_t stateId = snapshot.states[index];
+                            if (stateId < bakedModels_.size() && bakedModels_[stateId].lodDrawable) {
+                                bool surface = !isOccluder(index + PaddedChunkSnapshot::STRIDES[1]);
+                                addWeight(weights, stateId, surface ? static_cast<uint32_t>(scale) : 1);
                             }
                         }
+                    }
+                }
+                if (!filled) {
+                    continue;
+                }
 
-                        if (!shouldRender) {
-                            continue;
-                        }
+                int cellIndex = getCellIndex({cx, cy, cz});
+                cellFilled[cellIndex] = 1;
+                cellStates[cellIndex] = heaviest(weights);
+                if (cellStates[cellIndex] != 0) {
+                    addWeight(chunkWeights, cellStates[cellIndex], 1);
+                }
+            }
+        }
+    }
 
-                        glm::vec3 corners[4];
-                        FaceUtils::getFaceVertices(rotatedFaceDir, finalFrom, finalTo, corners);
+    // Cells of only non-drawable occluders (odd-shaped full blocks) borrow the chunk's dominant block
+    const uint16_t fallbackState = heaviest(chunkWeights);
 
-                        glm::vec2 uvs[4];
-                        FaceUtils::convertUVs(face.uv, uvs);
+    thread_local std::array<uint8_t, PaddedChunkSnapshot::VOLUME> paddedLight;
+    thread_local std::array<uint8_t, PaddedChunkSnapshot::VOLUME> paddedOpaque;
+    if (light) {
+        buildPaddedLight(*light, paddedLight.data(), paddedOpaque.data());
+    }
 
-                        uint32_t faceTextureIndex = face.textureIndex;
-                        glm::vec3 normal = FaceUtils::getFaceNormal(rotatedFaceDir);
+    thread_local std::unordered_map<PackedLighting, uint32_t, PackedLightingHash> lightIndices;
+    lightIndices.clear();
+    auto getLightIndex = [&](const PackedLighting& lighting) -> uint32_t {
+        auto [it, inserted] = lightIndices.try_emplace(lighting, static_cast<uint32_t>(mesh.lighting.size()));
+        if (inserted) {
+            mesh.lighting.push_back(lighting);
+        }
+        return it->second;
+    };
 
-                        uint32_t quadIndex = quadLibrary_.getOrCreateQuad(normal, corners, uvs, faceTextureIndex);
+    // Coarse faces are lit evenly by the block in front of their middle (no smooth light or AO)
+    auto computeLodLighting = [&](int sample, bool tinted) -> PackedLighting {
+        uint32_t sky = 31;
+        uint32_t block = 0;
+        if (light && !paddedOpaque[sample]) {
+            sky = ((paddedLight[sample] & 0x0F) * 31) / ChunkLightData::MAX_LIGHT;
+            block = ((paddedLight[sample] >> 4) * 31) / ChunkLightData::MAX_LIGHT;
+        }
+        PackedLighting lighting;
+        uint32_t packed = packCornerLight(sky, block, tinted);
+        for (uint32_t& corner : lighting.corners) {
+            corner = packed;
+        }
+        return lighting;
+    };
 
-                        PackedLighting lighting;
-                        if (face.tintindex.has_value()) {
-                            uint8_t grassR = static_cast<uint8_t>((121 * 31) / 255);
-                            uint8_t grassG = static_cast<uint8_t>((192 * 31) / 255);
-                            uint8_t grassB = static_cast<uint8_t>((90 * 31) / 255);
-                            lighting = PackedLighting::uniform(grassR, grassG, grassB);
-                        } else {
-                            lighting = PackedLighting::uniform(31, 31, 31);
+    // Visible cell faces are written into the greedy mask at block resolution, so coplanar
+    // cell faces merge exactly like full-resolution ones
+    std::vector<uint32_t>& greedyMask = getGreedyMask();
+    FaceBuckets& buckets = getFaceBuckets();
+
+    for (int cz = 0; cz < cells; cz++) {
+        for (int cy = 0; cy < cells; cy++) {
+            for (int cx = 0; cx < cells; cx++) {
+                const glm::ivec3 cell(cx, cy, cz);
+                int cellIndex = getCellIndex(cell);
+                if (!cellFilled[cellIndex]) {
+                    continue;
+                }
+                uint16_t stateId = cellStates[cellIndex] != 0 ? cellStates[cellIndex] : fallbackState;
+                if (stateId == 0) {
+                    continue;
+                }
+                const BakedBlockModel& baked = bakedModels_[stateId];
+
+                for (int faceIndex = 0; faceIndex < 6; faceIndex++) {
+                    FaceDirection dir = FaceUtils::fromIndex(faceIndex);
+                    glm::ivec3 normal(FaceUtils::getFaceNormal(dir));
+                    int uAxis, vAxis, layerAxis;
+                    getGreedyAxes(dir, uAxis, vAxis, layerAxis);
+
+                    glm::ivec3 neighborCell = cell + normal;
+                    int neighborLayer = neighborCell[layerAxis];
+                    if (neighborLayer >= 0 && neighborLayer < cells) {
+                        if (cellFilled[getCellIndex(neighborCell)]) {
+                            continue;
                         }
-
-                        uint32_t lightIndex = 0;
-                        bool found = false;
-                        for (size_t i = 0; i < mesh.lighting.size(); i++) {
-                            const PackedLighting& existing = mesh.lighting[i];
-                            if (existing.corners[0] == lighting.corners[0] &&
-                                existing.corners[1] == lighting.corners[1] &&
-                                existing.corners[2] == lighting.corners[2] &&
-                                existing.corners[3] == lighting.corners[3]) {
-                                lightIndex = static_cast<uint32_t>(i);
-                                found = true;
-                                break;
+                    } else {
+                        // Chunk border: hidden only if the neighbor's blocks cover the whole cell face
+                        glm::ivec3 border = cell * scale;
+                        border[layerAxis] = neighborLayer < 0 ? -1 : static_cast<int>(CHUNK_SIZE);
+                        bool covered = true;
+                        for (int dv = 0; dv < scale && covered; dv++) {
+                            for (int du = 0; du < scale && covered; du++) {
+                                glm::ivec3 pos = border;
+                                pos[uAxis] += du;
+                                pos[vAxis] += dv;
+                                covered = isOccluder(PaddedChunkSnapshot::getIndex(pos.x, pos.y, pos.z));
                             }
                         }
-                        if (!found) {
-                            lightIndex = static_cast<uint32_t>(mesh.lighting.size());
-                            mesh.lighting.push_back(lighting);
+                        if (covered) {
+                            continue;
                         }
+                    }
 
-                        FaceData faceData = FaceData::pack(bx, by, bz, false, lightIndex, quadIndex);
-                        mesh.faces.push_back(faceData);
+                    // The face sits on the cell's outer block layer along its normal
+                    glm::ivec3 origin = cell * scale;
+                    if (normal[layerAxis] > 0) {
+                        origin[layerAxis] += scale - 1;
+                    }
+                    glm::ivec3 sample = origin + normal;
+                    sample[uAxis] += scale / 2;
+                    sample[vAxis] += scale / 2;
+                    int sampleIndex = PaddedChunkSnapshot::getIndex(sample.x, sample.y, sample.z);
+
+                    bool first = true;
+                    for (const BakedQuad& quad : baked.quads) {
+                        if (quad.face != dir || !quad.greedyMergeable || !quad.hasCullface || quad.cullface != dir) {
+                            continue;
+                        }
+                        uint32_t lightIndex = getLightIndex(computeLodLighting(sampleIndex, quad.tinted));
+
+                        if (first) {
+                            uint32_t key = ((lightIndex & 0xFFFF) << 16) | quad.quadIndex;
+                            for (int dv = 0; dv < scale; dv++) {
+                                for (int du = 0; du < scale; du++) {
+                                    glm::ivec3 pos = origin;
+                                    pos[uAxis] += du;
+                                    pos[vAxis] += dv;
+                                    greedyMask[getGreedyCellIndex(dir, pos.x, pos.y, pos.z)] = key;
+                                }
+                            }
+                            first = false;
+                            continue;
+                        }
+
+                        // Further full faces (overlays) cover the cell face on their own
+                        buckets[quad.bucket].push_back(FaceData::pack(origin.x, origin.y, origin.z, false,
+                                                                      lightIndex, quad.quadIndex, scale, scale));
+                        glm::ivec3 extent(1);
+                        extent[uAxis] = scale;
+                        extent[vAxis] = scale;
+                        mesh.growBounds(origin, origin + extent);
                     }
                 }
             }
         }
     }
 
+    emitGreedyFaces(greedyMask, mesh, buckets);
+    appendFaceBuckets(buckets, mesh);
+
     return mesh;
 }
 
@@ -665,12 +1683,21 @@ std::vector<CompactChunkMesh> ChunkManager::getReadyMeshes() {
     ZoneScoped;
     std::vector<CompactChunkMesh> meshes;
 
-    std::lock_guard<std::mutex> lock(readyMutex_);
-    while (!readyMeshes_.empty()) {
-        meshes.push_back(std::move(readyMeshes_.front()));
-        readyMeshes_.pop();
+    {
+        std::lock_guard<std::mutex> lock(readyMutex_);
+        while (!readyMeshes_.empty()) {
+            meshes.push_back(std::move(readyMeshes_.front()));
+            readyMeshes_.pop();
+        }
     }
 
+    // Drop meshes of unloaded chunks and of block versions that were already superseded
+    // (the newer ChunkData is mesh-dirty, so its own mesh is on the way)
+    std::erase_if(meshes, [this](const CompactChunkMesh& mesh) {
+        ChunkDataPtr chunk = storage_.get(mesh.position);
+        return !chunk || chunk->getVersion() > mesh.version;
+    });
+
     return meshes;
 }
 
@@ -680,33 +1707,35 @@ void ChunkManager::queueChunkRemesh(const ChunkPosition& pos) {
     }
 
     markDirty(pos);
-
-    std::lock_guard<std::mutex> lock(workQueueMutex_);
-    workQueue_.push({pos, false});
-    workQueueCV_.notify_one();
+    scheduler_.submit({pos, false});
 }
 
 void ChunkManager::queueNeighborRemesh(const ChunkPosition& pos) {
-    std::vector<ChunkPosition> neighborsToQueue;
+    std::vector<MeshWorkItem> items;
 
-    for (const auto& offset : ChunkPosition::getFaceNeighborOffsets()) {
-        ChunkPosition neighborPos = pos.getNeighbor(offset.x, offset.y, offset.z);
-        if (storage_.contains(neighborPos)) {
-            markDirty(neighborPos);
-            neighborsToQueue.push_back(neighborPos);
+    // The mesher reads all 26 neighbors (faces, AO and smooth light across edges)
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if (dx == 0 && dy == 0 && dz == 0) {
+                    continue;
+                }
+                ChunkPosition neighborPos = pos.getNeighbor(dx, dy, dz);
+                ChunkDataPtr neighbor = storage_.get(neighborPos);
+                // Still-dirty neighbors have a job pending that will snapshot pos
+                if (neighbor && neighbor->markMeshDirty()) {
+                    items.push_back({neighborPos, false});
+                }
+            }
         }
     }
 
-    if (!neighborsToQueue.empty()) {
-        std::lock_guard<std::mutex> lock(workQueueMutex_);
-        for (const auto& neighborPos : neighborsToQueue) {
-            workQueue_.push({neighborPos, false});
-        }
-        workQueueCV_.notify_all();
+    if (!items.empty()) {
+        scheduler_.submitBatch(items);
     }
 }
 
-bool ChunkManager::areNeighborsLoadedForMeshing(const ChunkPosition& pos) const {
+bool ChunkManager::waitForNeighbors(const ChunkPosition& pos, ChunkStage stage) {
     // Lock-free read of camera position
     ChunkPosition cameraChunkPos{
         lastCameraChunkX_.load(std::memory_order_relaxed),
@@ -714,44 +1743,57 @@ bool ChunkManager::areNeighborsLoadedForMeshing(const ChunkPosition& pos) const
         lastCameraChunkZ_.load(std::memory_order_relaxed)
     };
 
-    for (const auto& offset : ChunkPosition::getFaceNeighborOffsets()) {
-        ChunkPosition neighborPos = pos.getNeighbor(offset.x, offset.y, offset.z);
-
-        if (neighborPos.distanceTo(cameraChunkPos) <= renderDistance_) {
-            if (!storage_.contains(neighborPos)) {
-                return false;
-            }
+    return dependencies_.waitForNeighbors(pos, stage, [&](const ChunkPosition& neighborPos) {
+        // Neighbors outside render distance won't be loaded; mesh without them
+        if (neighborPos.distanceTo(cameraChunkPos) > renderDistance_) {
+            return true;
         }
-    }
-
-    return true;
+        return stage == ChunkStage::Generated ? storage_.contains(neighborPos) : lightEngine_.hasLight(neighborPos);
+    });
 }
 
-void ChunkManager::markDirty(const ChunkPosition& pos) {
-    std::lock_guard<std::mutex> lock(dirtyMutex_);
-    dirtyChunks_.insert(pos);
+void ChunkManager::completeStage(const ChunkPosition& pos, ChunkStage stage) {
+    std::vector<ChunkPosition> runnable;
+    dependencies_.complete(pos, stage, runnable);
+    if (!runnable.empty()) {
+        resubmitParked(runnable);
+    }
 }
 
-bool ChunkManager::isDirty(const ChunkPosition& pos) const {
-    std::lock_guard<std::mutex> lock(dirtyMutex_);
-    return dirtyChunks_.find(pos) != dirtyChunks_.end();
+void ChunkManager::resubmitParked(const std::vector<ChunkPosition>& positions) {
+    std::vector<MeshWorkItem> items;
+    items.reserve(positions.size());
+    for (const auto& pos : positions) {
+        // Parked chunks were generated already; a missing one was unloaded and must not come back
+        if (storage_.contains(pos)) {
+            items.push_back({pos, false});
+        }
+    }
+    if (!items.empty()) {
+        scheduler_.submitBatch(items);
+    }
 }
 
-void ChunkManager::clearDirty(const ChunkPosition& pos) {
-    std::lock_guard<std::mutex> lock(dirtyMutex_);
-    dirtyChunks_.erase(pos);
+void ChunkManager::markDirty(const ChunkPosition& pos) {
+    if (ChunkDataPtr chunk = storage_.get(pos)) {
+        chunk->markMeshDirty();
+    }
 }
 
 void ChunkManager::notifyNeighbors(const glm::ivec3& worldPos, BlockState newState) {
+    ChunkEditBatch batch(*this);
+    notifyNeighbors(batch, worldPos, newState);
+    applyEdits(batch);
+}
+
+void ChunkManager::notifyNeighbors(ChunkEditBatch& batch, const glm::ivec3& worldPos, BlockState newState) {
     const glm::ivec3 directions[] = {
         {1, 0, 0}, {-1, 0, 0}, {0, 0, 1}, {0, 0, -1}, {0, 1, 0}, {0, -1, 0}
     };
 
-    std::vector<ChunkPosition> chunksToRemesh;
-
     for (const auto& dir : directions) {
         glm::ivec3 neighborPos = worldPos + dir;
-        BlockState neighborState = getBlockState(neighborPos);
+        BlockState neighborState = batch.getBlockState(neighborPos);
 
         if (neighborState.id == BlockRegistry::AIR->getDefaultState().id) {
             continue;
@@ -760,10 +1802,10 @@ void ChunkManager::notifyNeighbors(const glm::ivec3& worldPos, BlockState newSta
         Block* neighborBlock = BlockRegistry::getBlock(neighborState);
 
         BlockState updatedState = neighborBlock->updateShape(
-            neighborState, *this, neighborPos, -dir, worldPos, newState);
+            neighborState, batch, neighborPos, -dir, worldPos, newState);
 
         if (updatedState.id != neighborState.id) {
-            setBlockState(neighborPos, updatedState);
+            batch.setBlockState(neighborPos, updatedState);
         }
     }
 }
@@ -4,24 +4,39 @@
 #include "ChunkData.hpp"
 #include "ChunkStorage.hpp"
 #include "BlockModel.hpp"
+#include "BakedBlockModel.hpp"
+#include "ChunkOccupancy.hpp"
+#include "PaddedChunkSnapshot.hpp"
 #include "FaceCullingSystem.hpp"
 #include "ChunkGpuData.hpp"
+#include "ChunkJobScheduler.hpp"
+#include "ChunkDependencyTracker.hpp"
+#include "ChunkEditBatch.hpp"
+#include "RegionStorage.hpp"
+#include "ChunkShellTables.hpp"
+#include "LightEngine.hpp"
+#include "TerrainGenerator.hpp"
 #include "physics/BlockGetter.hpp"
 #include <glm/glm.hpp>
+#include <array>
 #include <memory>
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
 #include <queue>
 #include <atomic>
-#include <condition_variable>
 #include <unordered_set>
+#include <filesystem>
 
 namespace FarHorizon {
 
 /**
  * Manages a library of unique quad geometries.
  * Multiple faces can reference the same QuadInfo to save memory.
+ *
+ * Thread-safe and append-only: indices are stable once handed out, so the renderer
+ * only ever uploads the quads added since its last upload.
  */
 class QuadInfoLibrary {
 public:
@@ -34,8 +49,15 @@ public:
                              const glm::vec2 uvs[4],
                              uint32_t textureSlot);
 
-    const std::vector<QuadInfo>& getQuads() const { return quads_; }
-    void clear() { quads_.clear(); quadMap_.clear(); }
+    size_t size() const;
+
+    /**
+     * Copy up to count quads starting at index first into dest.
+     * Returns the number of quads copied.
+     */
+    size_t copyQuads(size_t first, size_t count, QuadInfo* dest) const;
+
+    void clear();
 
 private:
     struct QuadKey {
@@ -51,24 +73,19 @@ private:
         size_t operator()(const QuadKey& key) const;
     };
 
+    mutable std::shared_mutex mutex_;
     std::vector<QuadInfo> quads_;
     std::unordered_map<QuadKey, uint32_t, QuadKeyHash> quadMap_;
 };
 
-/**
- * Work item for mesh generation queue.
- */
-struct MeshWorkItem {
-    ChunkPosition position;
-    bool isNewChunk;  // True if chunk was just generated (needs neighbor remesh)
-};
-
 /**
  * High-performance chunk manager with lock-free parallel meshing.
  *
  * Architecture:
  * - ChunkStorage: Sharded concurrent storage (64 shards, shared_mutex each)
- * - Mesh workers: Grab shared_ptr snapshots, release ALL locks, mesh in parallel
+ * - ChunkJobScheduler: Camera-priority, deduplicated per-worker job heaps with work stealing
+ * - LightEngine: Per-chunk sky/block light, relit by the workers before meshing
+ * - Mesh workers: Grab shared_ptr snapshots, release ALL locks, light and mesh in parallel
  * - Zero synchronization during mesh generation (the expensive part)
  *
  * Thread safety:
@@ -78,22 +95,49 @@ struct MeshWorkItem {
  */
 class ChunkManager : public BlockGetter {
 public:
-    ChunkManager();
+    // Full resolution plus 2x, 4x and 8x downsampled meshes
+    static constexpr int LOD_LEVEL_COUNT = 4;
+
+    // Defaults to HeightmapTerrainGenerator when no generator is given
+    explicit ChunkManager(std::unique_ptr<TerrainGenerator> terrainGenerator = nullptr);
     ~ChunkManager();
 
     void initializeBlockModels();
     void preloadBlockStateModels();
     void registerTexture(const std::string& textureName, uint32_t textureIndex);
     std::vector<std::string> getRequiredTextures() const;
+    // Caches texture indices and bakes per-state quad tables (call after all textures are registered)
     void cacheTextureIndices();
     void precacheBlockShapes();
 
     void setRenderDistance(int32_t distance);
     int32_t getRenderDistance() const { return renderDistance_; }
 
-    void update(const glm::vec3& cameraPosition);
+    // Greedy meshing merges coplanar full faces into rectangles (remeshes loaded chunks on change)
+    void setGreedyMeshing(bool enabled);
+    bool isGreedyMeshingEnabled() const { return greedyMeshing_.load(std::memory_order_relaxed); }
+
+    /**
+     * Chunks further than radii[i] chunks from the camera are meshed at level i + 1
+     * (cells of 2^(i+1) blocks). A radius <= 0 disables that level and all coarser ones.
+     * Loaded chunks switch gradually as update() sweeps them.
+     */
+    void setLodRadii(const std::array<int32_t, LOD_LEVEL_COUNT - 1>& radii);
+
+    // viewDirection biases job order towards what the camera is looking at (zero = distance only)
+    void update(const glm::vec3& cameraPosition, const glm::vec3& viewDirection = glm::vec3(0.0f));
     void clearAllChunks();
 
+    /**
+     * Persist chunks to region files under directory. Saved chunks are then loaded
+     * by the job workers instead of being generated; unloaded chunks are written back.
+     * Without a world directory chunks only live in memory.
+     */
+    bool openWorld(const std::filesystem::path& directory);
+
+    // Queue every loaded chunk that differs from its saved copy for writing
+    void saveAllChunks();
+
     ChunkPosition worldToChunkPos(const glm::vec3& worldPos) const;
 
     // Chunk access - returns shared_ptr for safe concurrent access
@@ -106,22 +150,48 @@ public:
     // Block modification - uses copy-on-write
     void setBlockState(const glm::ivec3& worldPos, BlockState state);
 
-    // Mesh generation (called by workers, fully parallel)
-    CompactChunkMesh generateChunkMesh(ChunkDataPtr chunk,
-                                        const std::array<ChunkDataPtr, 7>& neighbors) const;
+    /**
+     * Commit a batch of edits: one copy-on-write per touched chunk, then every
+     * affected chunk (touched chunks plus neighbors across edited boundaries)
+     * is queued for remeshing once. Edits in unloaded chunks are dropped.
+     * @return Number of chunks rewritten
+     */
+    size_t applyEdits(const ChunkEditBatch& batch);
+
+    // Bulk region operations (inclusive bounds, no neighbor shape updates), applied as one batch
+    size_t fillRegion(const glm::ivec3& min, const glm::ivec3& max, BlockState state);
+    size_t replaceRegion(const glm::ivec3& min, const glm::ivec3& max, BlockState from, BlockState to);
+    size_t copyRegion(const glm::ivec3& srcMin, const glm::ivec3& srcMax, const glm::ivec3& dstMin);
+
+    // Mesh generation (called by workers, fully parallel). Meshes the center of chunks
+    // (missing neighbors read as air); without light the mesh uses full sky light plus ambient occlusion.
+    CompactChunkMesh generateChunkMesh(const ChunkNeighborhood& chunks,
+                                        const ChunkLightNeighborhood* light = nullptr) const;
+
+    // Mesh the center of chunks from cells of 2^lodLevel blocks (1 <= lodLevel < LOD_LEVEL_COUNT),
+    // each drawn as a full block of its dominant occluder. Evenly lit, no ambient occlusion.
+    CompactChunkMesh generateLodMesh(const ChunkNeighborhood& chunks, int lodLevel,
+                                     const ChunkLightNeighborhood* light = nullptr) const;
 
     bool hasReadyMeshes() const;
     std::vector<CompactChunkMesh> getReadyMeshes();
 
     // Queue a chunk for remeshing
     void queueChunkRemesh(const ChunkPosition& pos);
+    // Remesh the neighbors of pos that were already meshed (ones awaiting their first mesh will see it anyway)
     void queueNeighborRemesh(const ChunkPosition& pos);
 
     // Neighbor update system (for stairs, redstone, etc.)
     void notifyNeighbors(const glm::ivec3& worldPos, BlockState newState);
 
-    // Get the global QuadInfo buffer (shared across all chunks)
-    const std::vector<QuadInfo>& getQuadInfos() const { return quadLibrary_.getQuads(); }
+    // Same, but reads and records shape updates through a pending batch
+    void notifyNeighbors(ChunkEditBatch& batch, const glm::ivec3& worldPos, BlockState newState);
+
+    // Global QuadInfo library (shared across all chunks, append-only)
+    size_t getQuadInfoCount() const { return quadLibrary_.size(); }
+    size_t copyQuadInfos(size_t first, size_t count, QuadInfo* dest) const {
+        return quadLibrary_.copyQuads(first, count, dest);
+    }
 
     // Storage access for external iteration
     const ChunkStorage& getStorage() const { return storage_; }
@@ -136,36 +206,68 @@ private:
     std::atomic<int32_t> lastCameraChunkY_{INT32_MAX};
     std::atomic<int32_t> lastCameraChunkZ_{INT32_MAX};
     std::atomic<bool> renderDistanceChanged_{false};
+    glm::vec3 lastViewDirection_{0.0f};  // Direction the job priorities were last computed for
+
+    // Load (renderDistance) and unload (renderDistance + 1) offset tables, main thread only
+    std::unique_ptr<ChunkShellTables> loadShell_;
+    std::unique_ptr<ChunkShellTables> unloadShell_;
+    size_t unloadSweepShard_ = 0;  // Next shard for the incremental stray-chunk sweep
+    std::atomic<bool> greedyMeshing_{true};
+    std::array<std::atomic<int32_t>, LOD_LEVEL_COUNT - 1> lodRadii_{};  // Read by the mesh workers
+    size_t lodSweepShard_ = 0;  // Next shard for the incremental LOD level sweep
 
     mutable BlockModelManager modelManager_;
     mutable FaceCullingSystem cullingSystem_;
     mutable QuadInfoLibrary quadLibrary_;
 
+    // Baked quad tables indexed by blockstate ID (read-only once textures are cached)
+    std::vector<BakedBlockModel> bakedModels_;
+    std::vector<uint8_t> occlusionFlags_;  // OcclusionFlags per blockstate ID, same lifetime
+
+    // Region file persistence (must outlive the worker threads)
+    RegionStorage regionStorage_;
+
+    // Terrain source for chunks not on disk (must outlive the worker threads)
+    std::unique_ptr<TerrainGenerator> terrainGenerator_;
+
+    // Published light per chunk (must outlive the worker threads)
+    LightEngine lightEngine_;
+
+    // Jobs parked until their neighbors are generated/lit (must outlive the worker threads)
+    ChunkDependencyTracker dependencies_;
+
+    // Generation/meshing jobs (must outlive the worker threads)
+    ChunkJobScheduler scheduler_;
+
     // Worker threads
     std::vector<std::thread> workerThreads_;
-    std::atomic<bool> running_{true};
-
-    // Work queue (protected by mutex, but workers release lock before heavy work)
-    std::queue<MeshWorkItem> workQueue_;
-    std::mutex workQueueMutex_;
-    std::condition_variable workQueueCV_;
 
     // Ready meshes queue
     std::queue<CompactChunkMesh> readyMeshes_;
     mutable std::mutex readyMutex_;
 
-    // Dirty tracking (which chunks need remeshing)
-    std::unordered_set<ChunkPosition, ChunkPositionHash> dirtyChunks_;
-    mutable std::mutex dirtyMutex_;
+    // Snapshot order of produced meshes (see CompactChunkMesh::sequence)
+    std::atomic<uint64_t> meshSequence_{0};
 
+    void bakeBlockModels();
     void loadChunksAroundPosition(const ChunkPosition& centerPos);
     void unloadDistantChunks(const ChunkPosition& centerPos);
+    void updateLoadedShell(const ChunkPosition& from, const ChunkPosition& to);
+    void sweepDistantChunks(const ChunkPosition& centerPos);
+    // Queue remeshes for chunks in the next storage shards whose LOD level should change
+    void sweepLodLevels(const ChunkPosition& centerPos);
+    // LOD level for a chunk distance chunks from the camera, last meshed at previousLevel
+    uint8_t selectLodLevel(float distance, uint8_t previousLevel) const;
+    void saveRemovedChunks(const std::vector<ChunkDataPtr>& removed);
+    void saveChunkIfModified(const ChunkDataPtr& chunk);
     void meshWorker(unsigned int threadId);
 
-    bool areNeighborsLoadedForMeshing(const ChunkPosition& pos) const;
+    // Park pos until its neighbors inside render distance reach stage; false if they already have
+    bool waitForNeighbors(const ChunkPosition& pos, ChunkStage stage);
+    // pos reached stage: resubmit the jobs that were waiting only on it
+    void completeStage(const ChunkPosition& pos, ChunkStage stage);
+    void resubmitParked(const std::vector<ChunkPosition>& positions);
     void markDirty(const ChunkPosition& pos);
-    bool isDirty(const ChunkPosition& pos) const;
-    void clearDirty(const ChunkPosition& pos);
 };
 
 } // namespace FarHorizon
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "ChunkOccupancy.hpp"
+#include <tracy/Tracy.hpp>
+#include <bit>
+
+namespace FarHorizon {
+
+static uint8_t getStateFlags(const std::vector<uint8_t>& stateFlags, uint16_t stateId) {
+    return stateId < stateFlags.size() ? stateFlags[stateId] : 0;
+}
+
+void ChunkOccupancy::build(const PaddedChunkSnapshot& snapshot, const std::vector<uint8_t>& stateFlags) {
+    ZoneScoped;
+
+    // Padded rows line up with the snapshot: row (y, z) is 18 consecutive states starting at x = -1
+    for (int32_t z = -1; z <= static_cast<int32_t>(CHUNK_SIZE); z++) {
+        for (int32_t y = -1; y <= static_cast<int32_t>(CHUNK_SIZE); y++) {
+            const uint16_t* states = &snapshot.states[PaddedChunkSnapshot::getIndex(-1, y, z)];
+            uint32_t airRow = 0;
+            uint32_t occluderRow = 0;
+            uint32_t cubeRow = 0;
+            for (uint32_t bit = 0; bit < PADDED_SIZE; bit++) {
+                uint8_t flags = getStateFlags(stateFlags, states[bit]);
+                airRow |= static_cast<uint32_t>((flags & OCCLUSION_AIR) != 0) << bit;
+                occluderRow |= static_cast<uint32_t>((flags & OCCLUSION_OCCLUDER) != 0) << bit;
+                cubeRow |= static_cast<uint32_t>((flags & OCCLUSION_FULL_CUBE) != 0) << bit;
+            }
+
+            // Bits past the east neighbor read as air
+            uint32_t row = getRowIndex(y, z);
+            air[row] = airRow | ~PADDED_BITS;
+            occluder[row] = occluderRow;
+
+            bool interior = y >= 0 && z >= 0 && y < static_cast<int32_t>(CHUNK_SIZE) && z < static_cast<int32_t>(CHUNK_SIZE);
+            if (interior) {
+                fullCube[y + z * CHUNK_SIZE] = cubeRow & INTERIOR_BITS;
+            }
+        }
+    }
+}
+
+uint16_t ChunkOccupancy::computeFaceConnectivity() const {
+    ZoneScoped;
+
+    constexpr int SIZE = static_cast<int>(CHUNK_SIZE);
+    constexpr int LAST = SIZE - 1;
+
+    // A chunk with fewer occluders than one full slice cannot wall any face off from another
+    int occluderCount = 0;
+    for (int z = 0; z < SIZE; z++) {
+        for (int y = 0; y < SIZE; y++) {
+            occluderCount += std::popcount(occluder[getRowIndex(y, z)] & INTERIOR_BITS);
+        }
+    }
+    if (occluderCount < SIZE * SIZE) {
+        return FACE_CONNECTIVITY_ALL;
+    }
+
+    // Cell index x + y * 16 + z * 256; occluders start out visited so the fill never enters them
+    std::array<uint8_t, CHUNK_VOLUME> visited;
+    for (int z = 0; z < SIZE; z++) {
+        for (int y = 0; y < SIZE; y++) {
+            uint32_t row = occluder[getRowIndex(y, z)];
+            for (int x = 0; x < SIZE; x++) {
+                visited[x + y * SIZE + z * SIZE * SIZE] = (row >> (x + 1)) & 1;
+            }
+        }
+    }
+
+    uint16_t connectivity = 0;
+    thread_local std::vector<uint16_t> stack;
+    for (int start = 0; start < static_cast<int>(CHUNK_VOLUME); start++) {
+        if (visited[start]) {
+            continue;
+        }
+
+        // Faces (FaceUtils order) touched by this connected region
+        uint8_t faces = 0;
+        visited[start] = 1;
+        stack.push_back(static_cast<uint16_t>(start));
+        while (!stack.empty()) {
+            int cell = stack.back();
+            stack.pop_back();
+            int x = cell % SIZE;
+            int y = (cell / SIZE) % SIZE;
+            int z = cell / (SIZE * SIZE);
+
+            auto visit = [&](bool inside, int neighbor, int face) {
+                if (!inside) {
+                    faces |= 1u << face;
+                } else if (!visited[neighbor]) {
+                    visited[neighbor] = 1;
+                    stack.push_back(static_cast<uint16_t>(neighbor));
+                }
+            };
+            visit(z < LAST, cell + SIZE * SIZE, 0);  // South (+Z)
+            visit(z > 0, cell - SIZE * SIZE, 1);     // North (-Z)
+            visit(x > 0, cell - 1, 2);               // West (-X)
+            visit(x < LAST, cell + 1, 3);            // East (+X)
+            visit(y < LAST, cell + SIZE, 4);         // Up (+Y)
+            visit(y > 0, cell - SIZE, 5);            // Down (-Y)
+        }
+
+        for (int a = 0; a < 6; a++) {
+            for (int b = a + 1; b < 6; b++) {
+                if ((faces >> a & 1) && (faces >> b & 1)) {
+                    connectivity |= getFacePairBit(a, b);
+                }
+            }
+        }
+        if (connectivity == FACE_CONNECTIVITY_ALL) {
+            break;
+        }
+    }
+    return connectivity;
+}
+
+} // namespace FarHorizon
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Chunk.hpp"
+#include "ChunkData.hpp"
+#include "PaddedChunkSnapshot.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace FarHorizon {
+
+// Per-blockstate flags feeding ChunkOccupancy (built once when models are baked)
+enum OcclusionFlags : uint8_t {
+    OCCLUSION_AIR = 1 << 0,        // Faces against it are always drawn
+    OCCLUSION_OCCLUDER = 1 << 1,   // Full-cube outline shape: hides any face against it
+    OCCLUSION_FULL_CUBE = 1 << 2,  // FULL_CUBE baked model: culled from the masks alone
+};
+
+// Face connectivity masks: one bit per unordered pair of the six chunk faces (FaceUtils order)
+static constexpr int FACE_PAIR_COUNT = 15;
+static constexpr uint16_t FACE_CONNECTIVITY_ALL = (1u << FACE_PAIR_COUNT) - 1;
+
+constexpr uint16_t getFacePairBit(int a, int b) {
+    if (a > b) {
+        int t = a; a = b; b = t;
+    }
+    // Pairs (0,1)..(0,5), (1,2)..(1,5), ... numbered in order
+    return static_cast<uint16_t>(1u << (a * (11 - a) / 2 + b - a - 1));
+}
+
+/**
+ * Bitmask occupancy of one chunk plus the border slices of its six neighbors.
+ *
+ * Rows run along X: bit x + 1 of a row is block x, bits 0 and 17 are the
+ * west/east neighbor blocks. Padded rows (y or z of -1 / 16) come from the
+ * down/up and north/south neighbors. Built from a PaddedChunkSnapshot, so
+ * missing neighbors read as air.
+ *
+ * Culling a row of 16 blocks in one direction is then a shift/row select and an AND.
+ */
+struct ChunkOccupancy {
+    static constexpr uint32_t PADDED_SIZE = CHUNK_SIZE + 2;
+    static constexpr uint32_t INTERIOR_BITS = ((1u << CHUNK_SIZE) - 1) << 1;
+    static constexpr uint32_t PADDED_BITS = (1u << PADDED_SIZE) - 1;
+
+    std::array<uint32_t, PADDED_SIZE * PADDED_SIZE> air;        // OCCLUSION_AIR
+    std::array<uint32_t, PADDED_SIZE * PADDED_SIZE> occluder;   // OCCLUSION_OCCLUDER
+    std::array<uint32_t, CHUNK_SIZE * CHUNK_SIZE> fullCube;     // OCCLUSION_FULL_CUBE, interior only
+
+    void build(const PaddedChunkSnapshot& snapshot, const std::vector<uint8_t>& stateFlags);
+
+    /**
+     * Which pairs of chunk faces are joined by a path through non-occluder blocks
+     * (flood fill over the interior). Used to cull chunks hidden behind solid terrain.
+     */
+    uint16_t computeFaceConnectivity() const;
+
+    static uint32_t getRowIndex(int32_t y, int32_t z) {
+        return static_cast<uint32_t>(y + 1) + static_cast<uint32_t>(z + 1) * PADDED_SIZE;
+    }
+
+    uint32_t getFullCubeRow(uint32_t y, uint32_t z) const { return fullCube[y + z * CHUNK_SIZE]; }
+
+    /**
+     * Row of the blocks adjacent to row (y, z) in direction faceIndex (FaceUtils order),
+     * aligned so bit x + 1 is the neighbor of block x.
+     */
+    static uint32_t getNeighborRow(const std::array<uint32_t, PADDED_SIZE * PADDED_SIZE>& rows,
+                                   int faceIndex, int32_t y, int32_t z) {
+        switch (faceIndex) {
+            case 0: return rows[getRowIndex(y, z + 1)];    // South (+Z)
+            case 1: return rows[getRowIndex(y, z - 1)];    // North (-Z)
+            case 2: return rows[getRowIndex(y, z)] << 1;   // West (-X)
+            case 3: return rows[getRowIndex(y, z)] >> 1;   // East (+X)
+            case 4: return rows[getRowIndex(y + 1, z)];    // Up (+Y)
+            default: return rows[getRowIndex(y - 1, z)];   // Down (-Y)
+        }
+    }
+};
+
+} // namespace FarHorizon
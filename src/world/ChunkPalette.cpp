@@ -1,49 +1,82 @@
 #include "ChunkPalette.hpp"
+#include "Chunk.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 namespace FarHorizon {
 
 ChunkPalette::ChunkPalette() {
     // Initialize with AIR at index 0
     palette_.push_back(0);
-    indexMap_[0] = 0;
+    insertLookup(0, 0);
 }
 
-uint16_t ChunkPalette::getStateId(uint8_t index) const {
+ChunkPalette::ChunkPalette(std::vector<uint16_t> states)
+    : palette_(std::move(states)) {
+    sortedLookup_.reserve(palette_.size());
+    for (size_t i = 0; i < palette_.size(); i++) {
+        sortedLookup_.push_back((static_cast<uint32_t>(palette_[i]) << 16) | static_cast<uint32_t>(i));
+    }
+    std::sort(sortedLookup_.begin(), sortedLookup_.end());
+}
+
+void ChunkPalette::insertLookup(uint16_t stateId, uint16_t index) {
+    uint32_t entry = (static_cast<uint32_t>(stateId) << 16) | index;
+    sortedLookup_.insert(std::upper_bound(sortedLookup_.begin(), sortedLookup_.end(), entry), entry);
+}
+
+uint16_t ChunkPalette::getStateId(uint16_t index) const {
     if (index >= palette_.size()) {
-        spdlog::error("ChunkPaletteNew::getStateId - index {} out of bounds (size: {})",
+        spdlog::error("ChunkPalette::getStateId - index {} out of bounds (size: {})",
                       index, palette_.size());
         return 0; // Return AIR on error
     }
     return palette_[index];
 }
 
-uint8_t ChunkPalette::getOrAddIndex(uint16_t stateId) {
-    // Check if state is already in palette
-    auto it = indexMap_.find(stateId);
-    if (it != indexMap_.end()) {
-        return it->second;
+int32_t ChunkPalette::findIndex(uint16_t stateId) const {
+    if (palette_.size() <= LINEAR_SEARCH_LIMIT) {
+        for (size_t i = 0; i < palette_.size(); i++) {
+            if (palette_[i] == stateId) {
+                return static_cast<int32_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    uint32_t key = static_cast<uint32_t>(stateId) << 16;
+    auto it = std::lower_bound(sortedLookup_.begin(), sortedLookup_.end(), key);
+    if (it != sortedLookup_.end() && (*it >> 16) == stateId) {
+        return static_cast<int32_t>(*it & 0xFFFF);
+    }
+    return -1;
+}
+
+uint16_t ChunkPalette::getOrAddIndex(uint16_t stateId) {
+    int32_t existing = findIndex(stateId);
+    if (existing >= 0) {
+        return static_cast<uint16_t>(existing);
     }
 
-    // Add new state to palette
-    if (palette_.size() >= 256) {
-        spdlog::error("ChunkPaletteNew::getOrAddIndex - palette full! Cannot add state {}", stateId);
-        return 0; // Return AIR index on overflow
+    // A chunk can never reference more distinct states than it has blocks
+    if (palette_.size() >= CHUNK_VOLUME) {
+        spdlog::error("ChunkPalette::getOrAddIndex - palette full! Cannot add state {}", stateId);
+        return 0;
     }
 
-    uint8_t newIndex = static_cast<uint8_t>(palette_.size());
+    uint16_t newIndex = static_cast<uint16_t>(palette_.size());
     palette_.push_back(stateId);
-    indexMap_[stateId] = newIndex;
+    insertLookup(stateId, newIndex);
     return newIndex;
 }
 
 void ChunkPalette::clear() {
     palette_.clear();
-    indexMap_.clear();
+    sortedLookup_.clear();
 
     // Re-initialize with AIR
     palette_.push_back(0);
-    indexMap_[0] = 0;
+    insertLookup(0, 0);
 }
 
-} // namespace FarHorizon
\ No newline at end of file
+} // namespace FarHorizon
@@ -1,7 +1,6 @@
 #pragma once
 #include "BlockState.hpp"
 #include <vector>
-#include <unordered_map>
 #include <cstdint>
 
 namespace FarHorizon {
@@ -10,13 +9,23 @@ namespace FarHorizon {
 // Saves memory - stores only the blockstates actually used in this chunk
 class ChunkPalette {
 public:
+    // Palette with a single AIR entry at index 0
     ChunkPalette();
 
+    // Palette with exactly these states (index i -> states[i]), states must be unique
+    explicit ChunkPalette(std::vector<uint16_t> states);
+
     // Get the blockstate for a local index
-    uint16_t getStateId(uint8_t index) const;
+    uint16_t getStateId(uint16_t index) const;
 
     // Get the local index for a blockstate (adds to palette if not present)
-    uint8_t getOrAddIndex(uint16_t stateId);
+    uint16_t getOrAddIndex(uint16_t stateId);
+
+    // Get the local index for a blockstate, or -1 if not present
+    int32_t findIndex(uint16_t stateId) const;
+
+    // All entries in local index order
+    const std::vector<uint16_t>& getStates() const { return palette_; }
 
     // Get the number of entries in the palette
     size_t size() const { return palette_.size(); }
@@ -28,8 +37,13 @@ public:
     void clear();
 
 private:
-    std::vector<uint16_t> palette_;                      // Local index -> Global state ID
-    std::unordered_map<uint16_t, uint8_t> indexMap_;     // Global state ID -> Local index
+    // Palettes this small are searched linearly, larger ones through sortedLookup_
+    static constexpr size_t LINEAR_SEARCH_LIMIT = 16;
+
+    std::vector<uint16_t> palette_;       // Local index -> Global state ID
+    std::vector<uint32_t> sortedLookup_;  // (stateId << 16 | localIndex), sorted by state ID
+
+    void insertLookup(uint16_t stateId, uint16_t index);
 };
 
-} // namespace FarHorizon
\ No newline at end of file
+} // namespace FarHorizon
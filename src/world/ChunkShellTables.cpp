@@ -0,0 +1,56 @@
+#include "ChunkShellTables.hpp"
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+
+namespace FarHorizon {
+
+static int32_t lengthSquared(const glm::ivec3& v) {
+    return v.x * v.x + v.y * v.y + v.z * v.z;
+}
+
+ChunkShellTables::ChunkShellTables(int32_t radius)
+    : radius_(radius) {
+    ZoneScoped;
+
+    for (int32_t x = -radius; x <= radius; x++) {
+        for (int32_t y = -radius; y <= radius; y++) {
+            for (int32_t z = -radius; z <= radius; z++) {
+                glm::ivec3 offset(x, y, z);
+                if (isInside(offset)) {
+                    ball_.push_back(offset);
+                }
+            }
+        }
+    }
+
+    std::stable_sort(ball_.begin(), ball_.end(), [](const glm::ivec3& a, const glm::ivec3& b) {
+        return lengthSquared(a) < lengthSquared(b);
+    });
+
+    const auto steps = ChunkPosition::getFaceNeighborOffsets();
+    for (size_t dir = 0; dir < steps.size(); dir++) {
+        const glm::ivec3 step = steps[dir];
+        for (const glm::ivec3& offset : ball_) {
+            // Entering: inside around the new center, outside around the old one (old = new - step)
+            if (!isInside(offset + step)) {
+                entering_[dir].push_back(offset);
+            }
+            // Leaving: inside around the old center, outside around the new one (new = old + step)
+            if (!isInside(offset - step)) {
+                leaving_[dir].push_back(offset);
+            }
+        }
+    }
+}
+
+int ChunkShellTables::getDirectionIndex(const glm::ivec3& step) {
+    const auto steps = ChunkPosition::getFaceNeighborOffsets();
+    for (size_t dir = 0; dir < steps.size(); dir++) {
+        if (steps[dir] == step) {
+            return static_cast<int>(dir);
+        }
+    }
+    return -1;
+}
+
+} // namespace FarHorizon
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Chunk.hpp"
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace FarHorizon {
+
+/**
+ * Precomputed chunk offsets for a spherical radius (offset o is inside when |o| <= radius).
+ *
+ * Moving the center one chunk only changes a thin shell of the sphere, so the
+ * tables let ChunkManager touch ~pi*r^2 positions per step instead of the
+ * whole (2r+1)^3 cube.
+ *
+ * Step directions use ChunkPosition::getFaceNeighborOffsets() order:
+ * West, East, Down, Up, North, South.
+ */
+class ChunkShellTables {
+public:
+    explicit ChunkShellTables(int32_t radius);
+
+    int32_t getRadius() const { return radius_; }
+
+    // Every offset inside the sphere, nearest first
+    const std::vector<glm::ivec3>& getBallOffsets() const { return ball_; }
+
+    // Offsets relative to the NEW center that enter the sphere when the center steps by direction
+    const std::vector<glm::ivec3>& getEnteringOffsets(size_t direction) const { return entering_[direction]; }
+
+    // Offsets relative to the OLD center that leave the sphere when the center steps by direction
+    const std::vector<glm::ivec3>& getLeavingOffsets(size_t direction) const { return leaving_[direction]; }
+
+    bool isInside(const glm::ivec3& offset) const {
+        return offset.x * offset.x + offset.y * offset.y + offset.z * offset.z <= radius_ * radius_;
+    }
+
+    // Index into the step tables for a unit step, or -1 if step is not a unit axis step
+    static int getDirectionIndex(const glm::ivec3& step);
+
+private:
+    int32_t radius_;
+    std::vector<glm::ivec3> ball_;
+    std::array<std::vector<glm::ivec3>, 6> entering_;
+    std::array<std::vector<glm::ivec3>, 6> leaving_;
+};
+
+} // namespace FarHorizon
@@ -1,43 +1,146 @@
 #include "ChunkStorage.hpp"
 #include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <cstdint>
 
 namespace FarHorizon {
 
+// Initial slots per shard and maximum (full + tombstone) load before growing
+static constexpr size_t INITIAL_SHARD_CAPACITY = 16;
+static constexpr size_t MAX_LOAD_NUMERATOR = 7;
+static constexpr size_t MAX_LOAD_DENOMINATOR = 10;
+
+// ===== Shard (flat open-addressing table) =====
+
+size_t ChunkStorage::Shard::find(const ChunkPosition& pos) const {
+    if (slots.empty()) {
+        return SIZE_MAX;
+    }
+
+    size_t mask = slots.size() - 1;
+    for (size_t i = ChunkPositionHash{}(pos) & mask;; i = (i + 1) & mask) {
+        const Slot& slot = slots[i];
+        if (slot.state == SlotState::EMPTY) {
+            return SIZE_MAX;
+        }
+        if (slot.state == SlotState::FULL && slot.position == pos) {
+            return i;
+        }
+    }
+}
+
+size_t ChunkStorage::Shard::findOrReserve(const ChunkPosition& pos) {
+    if (slots.empty()) {
+        rehash(INITIAL_SHARD_CAPACITY);
+    } else if ((count + tombstones + 1) * MAX_LOAD_DENOMINATOR > slots.size() * MAX_LOAD_NUMERATOR) {
+        // Grow if genuinely full, otherwise just flush tombstones
+        rehash((count + 1) * 2 * MAX_LOAD_DENOMINATOR > slots.size() * MAX_LOAD_NUMERATOR
+               ? slots.size() * 2 : slots.size());
+    }
+
+    size_t mask = slots.size() - 1;
+    size_t firstTombstone = SIZE_MAX;
+    for (size_t i = ChunkPositionHash{}(pos) & mask;; i = (i + 1) & mask) {
+        Slot& slot = slots[i];
+        if (slot.state == SlotState::FULL) {
+            if (slot.position == pos) {
+                return i;
+            }
+        } else if (slot.state == SlotState::TOMBSTONE) {
+            if (firstTombstone == SIZE_MAX) {
+                firstTombstone = i;
+            }
+        } else {
+            // Not present: reuse the first tombstone on the probe path if there was one
+            size_t target = firstTombstone != SIZE_MAX ? firstTombstone : i;
+            if (slots[target].state == SlotState::TOMBSTONE) {
+                tombstones--;
+            }
+            slots[target].position = pos;
+            slots[target].state = SlotState::FULL;
+            count++;
+            return target;
+        }
+    }
+}
+
+void ChunkStorage::Shard::erase(size_t slot) {
+    slots[slot].state = SlotState::TOMBSTONE;
+    slots[slot].data.reset();
+    count--;
+    tombstones++;
+}
+
+void ChunkStorage::Shard::rehash(size_t capacity) {
+    std::vector<Slot> old = std::move(slots);
+    slots = std::vector<Slot>(capacity);
+    tombstones = 0;
+
+    size_t mask = capacity - 1;
+    for (auto& slot : old) {
+        if (slot.state != SlotState::FULL) {
+            continue;
+        }
+        size_t i = ChunkPositionHash{}(slot.position) & mask;
+        while (slots[i].state != SlotState::EMPTY) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = std::move(slot);
+    }
+}
+
+// ===== ChunkStorage =====
+
 ChunkDataPtr ChunkStorage::get(const ChunkPosition& pos) const {
     const Shard& shard = getShard(pos);
     std::shared_lock lock(shard.mutex);
 
-    auto it = shard.chunks.find(pos);
-    if (it != shard.chunks.end()) {
-        return it->second;  // Copy shared_ptr (atomic refcount increment)
+    size_t slot = shard.find(pos);
+    if (slot != SIZE_MAX) {
+        return shard.slots[slot].data;  // Copy shared_ptr (atomic refcount increment)
     }
     return nullptr;
 }
 
-std::array<ChunkDataPtr, 7> ChunkStorage::getWithNeighbors(const ChunkPosition& pos) const {
+ChunkNeighborhood ChunkStorage::getWithNeighbors(const ChunkPosition& pos) const {
     ZoneScoped;
 
-    std::array<ChunkDataPtr, 7> result{};
+    ChunkNeighborhood result;
 
-    // Positions: center, west, east, down, up, north, south
-    std::array<ChunkPosition, 7> positions = {{
-        pos,
-        {pos.x - 1, pos.y, pos.z},      // West
-        {pos.x + 1, pos.y, pos.z},      // East
-        {pos.x, pos.y - 1, pos.z},      // Down
-        {pos.x, pos.y + 1, pos.z},      // Up
-        {pos.x, pos.y, pos.z - 1},      // North
-        {pos.x, pos.y, pos.z + 1}       // South
-    }};
+    // Shard of every neighborhood slot; a 3x3x3 block spans at most 2 shard blocks per axis
+    std::array<uint8_t, 27> shardOf;
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                shardOf[ChunkNeighborhood::getIndex(dx, dy, dz)] =
+                    static_cast<uint8_t>(getShardIndex(pos.getNeighbor(dx, dy, dz)));
+            }
+        }
+    }
 
-    // Group positions by shard to minimize lock acquisitions
-    // For 7 chunks, worst case is 7 different shards, best case is 1
-    // On average, with 64 shards, we'll hit ~7 different shards
+    // Visit each distinct shard once, resolving all of its positions under one shared lock
+    uint32_t done = 0;
+    for (size_t first = 0; first < 27; first++) {
+        if (done & (1u << first)) {
+            continue;
+        }
 
-    // Simple approach: just do 7 lookups with RAII locks
-    // The shared_lock is extremely fast (~20ns) so this is fine
-    for (size_t i = 0; i < 7; i++) {
-        result[i] = get(positions[i]);
+        const Shard& shard = shards_[shardOf[first]];
+        std::shared_lock lock(shard.mutex);
+        for (size_t i = first; i < 27; i++) {
+            if (shardOf[i] != shardOf[first]) {
+                continue;
+            }
+            done |= 1u << i;
+
+            ChunkPosition neighbor = pos.getNeighbor(static_cast<int>(i % 3) - 1,
+                                                     static_cast<int>((i / 3) % 3) - 1,
+                                                     static_cast<int>(i / 9) - 1);
+            size_t slot = shard.find(neighbor);
+            if (slot != SIZE_MAX) {
+                result.chunks[i] = shard.slots[slot].data;
+            }
+        }
     }
 
     return result;
@@ -49,16 +152,9 @@ ChunkDataPtr ChunkStorage::insert(const ChunkPosition& pos, ChunkDataPtr data) {
     Shard& shard = getShard(pos);
     std::unique_lock lock(shard.mutex);
 
-    auto it = shard.chunks.find(pos);
-    ChunkDataPtr previous = nullptr;
-
-    if (it != shard.chunks.end()) {
-        previous = std::move(it->second);
-        it->second = std::move(data);
-    } else {
-        shard.chunks.emplace(pos, std::move(data));
-    }
-
+    size_t slot = shard.findOrReserve(pos);
+    ChunkDataPtr previous = std::move(shard.slots[slot].data);
+    shard.slots[slot].data = std::move(data);
     return previous;
 }
 
@@ -68,22 +164,22 @@ bool ChunkStorage::compareAndSwap(const ChunkPosition& pos, uint32_t expectedVer
     Shard& shard = getShard(pos);
     std::unique_lock lock(shard.mutex);
 
-    auto it = shard.chunks.find(pos);
-    if (it == shard.chunks.end()) {
+    size_t slot = shard.find(pos);
+    if (slot == SIZE_MAX) {
         // Chunk doesn't exist - only succeed if expectedVersion is 0 (new chunk)
         if (expectedVersion == 0) {
-            shard.chunks.emplace(pos, std::move(newData));
+            shard.slots[shard.findOrReserve(pos)].data = std::move(newData);
             return true;
         }
         return false;
     }
 
     // Check version matches
-    if (it->second->getVersion() != expectedVersion) {
+    if (shard.slots[slot].data->getVersion() != expectedVersion) {
         return false;  // Version mismatch - concurrent modification
     }
 
-    it->second = std::move(newData);
+    shard.slots[slot].data = std::move(newData);
     return true;
 }
 
@@ -93,10 +189,10 @@ ChunkDataPtr ChunkStorage::remove(const ChunkPosition& pos) {
     Shard& shard = getShard(pos);
     std::unique_lock lock(shard.mutex);
 
-    auto it = shard.chunks.find(pos);
-    if (it != shard.chunks.end()) {
-        ChunkDataPtr data = std::move(it->second);
-        shard.chunks.erase(it);
+    size_t slot = shard.find(pos);
+    if (slot != SIZE_MAX) {
+        ChunkDataPtr data = std::move(shard.slots[slot].data);
+        shard.erase(slot);
         return data;
     }
     return nullptr;
@@ -105,7 +201,7 @@ ChunkDataPtr ChunkStorage::remove(const ChunkPosition& pos) {
 bool ChunkStorage::contains(const ChunkPosition& pos) const {
     const Shard& shard = getShard(pos);
     std::shared_lock lock(shard.mutex);
-    return shard.chunks.find(pos) != shard.chunks.end();
+    return shard.find(pos) != SIZE_MAX;
 }
 
 std::vector<ChunkPosition> ChunkStorage::getAllPositions() const {
@@ -117,15 +213,17 @@ std::vector<ChunkPosition> ChunkStorage::getAllPositions() const {
     size_t totalSize = 0;
     for (const auto& shard : shards_) {
         std::shared_lock lock(shard.mutex);
-        totalSize += shard.chunks.size();
+        totalSize += shard.count;
     }
     positions.reserve(totalSize);
 
     // Collect all positions
     for (const auto& shard : shards_) {
         std::shared_lock lock(shard.mutex);
-        for (const auto& [pos, data] : shard.chunks) {
-            positions.push_back(pos);
+        for (const auto& slot : shard.slots) {
+            if (slot.state == SlotState::FULL) {
+                positions.push_back(slot.position);
+            }
         }
     }
 
@@ -140,9 +238,9 @@ std::vector<std::pair<ChunkPosition, ChunkDataPtr>> ChunkStorage::getChunksInRad
 
     for (const auto& shard : shards_) {
         std::shared_lock lock(shard.mutex);
-        for (const auto& [pos, data] : shard.chunks) {
-            if (pos.distanceTo(center) <= radius) {
-                result.emplace_back(pos, data);
+        for (const auto& slot : shard.slots) {
+            if (slot.state == SlotState::FULL && slot.position.distanceTo(center) <= radius) {
+                result.emplace_back(slot.position, slot.data);
             }
         }
     }
@@ -150,23 +248,68 @@ std::vector<std::pair<ChunkPosition, ChunkDataPtr>> ChunkStorage::getChunksInRad
     return result;
 }
 
-size_t ChunkStorage::removeOutsideRadius(const ChunkPosition& center, float radius) {
+size_t ChunkStorage::removeOutsideRadius(const ChunkPosition& center, float radius,
+                                         std::vector<ChunkDataPtr>* removed) {
+    return removeOutsideRadius(center, radius, removed, 0, NUM_SHARDS);
+}
+
+size_t ChunkStorage::removeOutsideRadius(const ChunkPosition& center, float radius, std::vector<ChunkDataPtr>* removed,
+                                         size_t firstShard, size_t shardCount) {
     ZoneScoped;
 
     size_t removedCount = 0;
 
-    for (auto& shard : shards_) {
+    for (size_t s = firstShard; s < std::min(firstShard + shardCount, NUM_SHARDS); s++) {
+        Shard& shard = shards_[s];
         std::unique_lock lock(shard.mutex);
 
-        auto it = shard.chunks.begin();
-        while (it != shard.chunks.end()) {
-            if (it->first.distanceTo(center) > radius) {
-                it = shard.chunks.erase(it);
+        for (size_t i = 0; i < shard.slots.size(); i++) {
+            Slot& slot = shard.slots[i];
+            if (slot.state == SlotState::FULL && slot.position.distanceTo(center) > radius) {
+                if (removed) {
+                    removed->push_back(std::move(slot.data));
+                }
+                shard.erase(i);
                 removedCount++;
-            } else {
-                ++it;
             }
         }
+
+        // Sweeps leave long tombstone runs behind; flush them while we hold the lock
+        if (shard.tombstones * 4 > shard.slots.size()) {
+            shard.rehash(shard.slots.size());
+        }
+    }
+
+    return removedCount;
+}
+
+size_t ChunkStorage::removeAll(const std::vector<ChunkPosition>& positions, std::vector<ChunkDataPtr>* removed) {
+    ZoneScoped;
+
+    std::array<std::vector<ChunkPosition>, NUM_SHARDS> byShard;
+    for (const auto& pos : positions) {
+        byShard[getShardIndex(pos)].push_back(pos);
+    }
+
+    size_t removedCount = 0;
+    for (size_t s = 0; s < NUM_SHARDS; s++) {
+        if (byShard[s].empty()) {
+            continue;
+        }
+
+        Shard& shard = shards_[s];
+        std::unique_lock lock(shard.mutex);
+        for (const auto& pos : byShard[s]) {
+            size_t slot = shard.find(pos);
+            if (slot == SIZE_MAX) {
+                continue;
+            }
+            if (removed) {
+                removed->push_back(std::move(shard.slots[slot].data));
+            }
+            shard.erase(slot);
+            removedCount++;
+        }
     }
 
     return removedCount;
@@ -177,7 +320,9 @@ void ChunkStorage::clear() {
 
     for (auto& shard : shards_) {
         std::unique_lock lock(shard.mutex);
-        shard.chunks.clear();
+        shard.slots.clear();
+        shard.count = 0;
+        shard.tombstones = 0;
     }
 }
 
@@ -185,7 +330,7 @@ size_t ChunkStorage::size() const {
     size_t total = 0;
     for (const auto& shard : shards_) {
         std::shared_lock lock(shard.mutex);
-        total += shard.chunks.size();
+        total += shard.count;
     }
     return total;
 }
@@ -3,12 +3,26 @@
 #include "ChunkData.hpp"
 #include <shared_mutex>
 #include <array>
-#include <unordered_map>
 #include <vector>
 #include <functional>
 
 namespace FarHorizon {
 
+/**
+ * A chunk and its 26 neighbors, indexed by (dx+1) + (dy+1)*3 + (dz+1)*9.
+ * Null entries for missing chunks.
+ */
+struct ChunkNeighborhood {
+    std::array<ChunkDataPtr, 27> chunks;
+
+    static constexpr size_t getIndex(int dx, int dy, int dz) {
+        return static_cast<size_t>((dx + 1) + (dy + 1) * 3 + (dz + 1) * 9);
+    }
+
+    const ChunkDataPtr& get(int dx, int dy, int dz) const { return chunks[getIndex(dx, dy, dz)]; }
+    const ChunkDataPtr& getCenter() const { return chunks[getIndex(0, 0, 0)]; }
+};
+
 /**
  * High-performance sharded chunk storage.
  *
@@ -17,11 +31,14 @@ namespace FarHorizon {
  * - shared_mutex allows unlimited concurrent readers per shard
  * - Readers NEVER block readers (even on same shard)
  * - shared_ptr ensures safe access after lock release
+ * - Shards own 4x4x4-chunk blocks, so a 3x3x3 neighborhood touches at most 8 shards
+ * - Each shard is a flat open-addressing table (linear probing, tombstones),
+ *   keyed by the mixed ChunkPositionHash
  *
  * Performance characteristics:
- * - Lookup: ~50ns (shared lock + hash lookup)
- * - Insert: ~100ns (exclusive lock on one shard only)
- * - Delete: ~100ns (exclusive lock on one shard only)
+ * - Lookup: shared lock + one short probe over contiguous slots
+ * - Insert/Delete: exclusive lock on one shard only
+ * - getWithNeighbors: one shared lock per distinct shard (usually 1-4)
  * - Concurrent reads: unlimited parallelism
  */
 class ChunkStorage {
@@ -42,12 +59,10 @@ public:
     ChunkDataPtr get(const ChunkPosition& pos) const;
 
     /**
-     * Get chunk + all 6 face neighbors in one operation.
-     * More efficient than 7 separate calls (fewer lock acquisitions).
-     * Returns array: [center, west, east, down, up, north, south]
-     * Null entries for missing chunks.
+     * Get chunk + all 26 neighbors in one operation.
+     * Positions are grouped by shard so each shard is locked once.
      */
-    std::array<ChunkDataPtr, 7> getWithNeighbors(const ChunkPosition& pos) const;
+    ChunkNeighborhood getWithNeighbors(const ChunkPosition& pos) const;
 
     /**
      * Insert or replace chunk data.
@@ -91,9 +106,25 @@ public:
 
     /**
      * Remove all chunks outside radius from center.
+     * @param removed If non-null, receives the removed chunk data (e.g. for saving)
      * @return Number of chunks removed
      */
-    size_t removeOutsideRadius(const ChunkPosition& center, float radius);
+    size_t removeOutsideRadius(const ChunkPosition& center, float radius,
+                               std::vector<ChunkDataPtr>* removed = nullptr);
+
+    /**
+     * Same, but only sweeps shards [firstShard, firstShard + shardCount).
+     * Lets callers spread a full sweep over several frames.
+     */
+    size_t removeOutsideRadius(const ChunkPosition& center, float radius, std::vector<ChunkDataPtr>* removed,
+                               size_t firstShard, size_t shardCount);
+
+    /**
+     * Remove many chunks, locking each affected shard once.
+     * @param removed If non-null, receives the removed chunk data
+     * @return Number of chunks removed
+     */
+    size_t removeAll(const std::vector<ChunkPosition>& positions, std::vector<ChunkDataPtr>* removed = nullptr);
 
     /**
      * Clear all chunks.
@@ -114,23 +145,63 @@ public:
     void forEach(Func&& func) const {
         for (size_t i = 0; i < NUM_SHARDS; i++) {
             std::shared_lock lock(shards_[i].mutex);
-            for (const auto& [pos, data] : shards_[i].chunks) {
-                func(pos, data);
+            for (const auto& slot : shards_[i].slots) {
+                if (slot.state == SlotState::FULL) {
+                    func(slot.position, slot.data);
+                }
+            }
+        }
+    }
+
+    /**
+     * Same as forEach(), limited to shardCount shards starting at firstShard (wrapping around),
+     * for sweeps spread over several calls.
+     */
+    template<typename Func>
+    void forEachInShards(size_t firstShard, size_t shardCount, Func&& func) const {
+        for (size_t n = 0; n < shardCount && n < NUM_SHARDS; n++) {
+            const Shard& shard = shards_[(firstShard + n) % NUM_SHARDS];
+            std::shared_lock lock(shard.mutex);
+            for (const auto& slot : shard.slots) {
+                if (slot.state == SlotState::FULL) {
+                    func(slot.position, slot.data);
+                }
             }
         }
     }
 
 private:
+    enum class SlotState : uint8_t { EMPTY, FULL, TOMBSTONE };
+
+    struct Slot {
+        ChunkPosition position{0, 0, 0};
+        SlotState state = SlotState::EMPTY;
+        ChunkDataPtr data;
+    };
+
     struct Shard {
         mutable std::shared_mutex mutex;
-        std::unordered_map<ChunkPosition, ChunkDataPtr, ChunkPositionHash> chunks;
+        std::vector<Slot> slots;  // Power-of-two capacity (empty until first insert)
+        size_t count = 0;
+        size_t tombstones = 0;
+
+        // Slot index holding pos, or SIZE_MAX (caller holds the lock)
+        size_t find(const ChunkPosition& pos) const;
+        // Slot index for inserting pos: its existing slot or a free one (grows as needed)
+        size_t findOrReserve(const ChunkPosition& pos);
+        void erase(size_t slot);
+        void rehash(size_t capacity);
     };
 
+    // Chunks per shard block edge, as a shift (4x4x4 chunks per block)
+    static constexpr int32_t SHARD_BLOCK_SHIFT = 2;
+
     std::array<Shard, NUM_SHARDS> shards_;
 
-    // Fast shard selection using position hash
-    size_t getShardIndex(const ChunkPosition& pos) const {
-        return ChunkPositionHash{}(pos) % NUM_SHARDS;
+    // Fast shard selection using the position of the chunk's shard block
+    static size_t getShardIndex(const ChunkPosition& pos) {
+        ChunkPosition block{pos.x >> SHARD_BLOCK_SHIFT, pos.y >> SHARD_BLOCK_SHIFT, pos.z >> SHARD_BLOCK_SHIFT};
+        return ChunkPositionHash{}(block) % NUM_SHARDS;
     }
 
     Shard& getShard(const ChunkPosition& pos) {
@@ -142,4 +213,4 @@ private:
     }
 };
 
-} // namespace FarHorizon
\ No newline at end of file
+} // namespace FarHorizon
@@ -0,0 +1,101 @@
+#include "ChunkVisibilityGraph.hpp"
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace FarHorizon {
+
+// Neighbor offset per face, FaceUtils order (the opposite face is index ^ 1)
+static constexpr std::array<glm::ivec3, 6> FACE_OFFSETS = {{
+    { 0,  0,  1},  // South
+    { 0,  0, -1},  // North
+    {-1,  0,  0},  // West
+    { 1,  0,  0},  // East
+    { 0,  1,  0},  // Up
+    { 0, -1,  0},  // Down
+}};
+
+void ChunkVisibilityGraph::set(const ChunkPosition& pos, uint16_t connectivity) {
+    connectivity_[pos] = connectivity;
+}
+
+void ChunkVisibilityGraph::erase(const ChunkPosition& pos) {
+    connectivity_.erase(pos);
+}
+
+void ChunkVisibilityGraph::clear() {
+    connectivity_.clear();
+}
+
+uint16_t ChunkVisibilityGraph::getConnectivity(const ChunkPosition& pos) const {
+    auto it = connectivity_.find(pos);
+    return it != connectivity_.end() ? it->second : FACE_CONNECTIVITY_ALL;
+}
+
+void ChunkVisibilityGraph::traverse(const Frustum& frustum, const glm::vec3& cameraPos, int32_t radius,
+                                    std::vector<ChunkPosition>& visible) {
+    ZoneScoped;
+    visible.clear();
+    queue_.clear();
+
+    // Same integer/fraction split as the shader's camera-relative transform
+    glm::vec3 cameraFloor = glm::floor(cameraPos);
+    glm::ivec3 cameraInt(cameraFloor);
+    glm::vec3 cameraFrac = cameraPos - cameraFloor;
+    glm::ivec3 cameraChunk(static_cast<int32_t>(std::floor(cameraPos.x / CHUNK_SIZE)),
+                           static_cast<int32_t>(std::floor(cameraPos.y / CHUNK_SIZE)),
+                           static_cast<int32_t>(std::floor(cameraPos.z / CHUNK_SIZE)));
+
+    int32_t diameter = 2 * radius + 1;
+    if (radius != stampRadius_) {
+        visitStamps_.assign(static_cast<size_t>(diameter) * diameter * diameter, 0);
+        stampRadius_ = radius;
+        stamp_ = 0;
+    }
+    if (++stamp_ == 0) {
+        std::fill(visitStamps_.begin(), visitStamps_.end(), 0);
+        stamp_ = 1;
+    }
+
+    queue_.push_back({ChunkPosition{cameraChunk.x, cameraChunk.y, cameraChunk.z}, -1, 0});
+    visitStamps_[(radius * diameter + radius) * diameter + radius] = stamp_;
+
+    for (size_t head = 0; head < queue_.size(); head++) {
+        Step step = queue_[head];
+        visible.push_back(step.pos);
+        uint16_t connectivity = getConnectivity(step.pos);
+
+        for (int face = 0; face < 6; face++) {
+            // Never walk back against a direction already taken
+            if (step.directions & (1u << (face ^ 1))) {
+                continue;
+            }
+            if (step.entryFace >= 0 && !(connectivity & getFacePairBit(step.entryFace, face))) {
+                continue;
+            }
+
+            glm::ivec3 next = glm::ivec3(step.pos.x, step.pos.y, step.pos.z) + FACE_OFFSETS[face];
+            glm::ivec3 local = next - cameraChunk + radius;
+            if (local.x < 0 || local.y < 0 || local.z < 0 ||
+                local.x >= diameter || local.y >= diameter || local.z >= diameter) {
+                continue;
+            }
+            uint32_t& stamp = visitStamps_[(local.z * diameter + local.y) * diameter + local.x];
+            if (stamp == stamp_) {
+                continue;
+            }
+
+            glm::vec3 min = glm::vec3(next * static_cast<int32_t>(CHUNK_SIZE) - cameraInt) - cameraFrac;
+            if (!frustum.intersectsBox(min, min + static_cast<float>(CHUNK_SIZE))) {
+                continue;
+            }
+
+            stamp = stamp_;
+            queue_.push_back({ChunkPosition{next.x, next.y, next.z}, static_cast<int8_t>(face ^ 1),
+                              static_cast<uint8_t>(step.directions | (1u << face))});
+        }
+    }
+}
+
+} // namespace FarHorizon
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Chunk.hpp"
+#include "ChunkOccupancy.hpp"
+#include "../util/Frustum.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace FarHorizon {
+
+/**
+ * Occlusion culling through chunk face connectivity ("cave culling").
+ *
+ * Holds each meshed chunk's face connectivity mask (CompactChunkMesh::connectivity).
+ * traverse() walks outwards from the camera's chunk, entering a neighbor only when
+ * the current chunk connects the face it was entered through to the face towards
+ * that neighbor, so chunks sealed off by solid terrain are never reached. A walk
+ * never steps against a direction it already took, which keeps it from bending
+ * back around occluders.
+ *
+ * Chunks without a mask (not meshed yet or not loaded) count as fully open so they
+ * never hide what is behind them.
+ *
+ * Not thread-safe (owned by the render thread).
+ */
+class ChunkVisibilityGraph {
+public:
+    ChunkVisibilityGraph() = default;
+
+    void set(const ChunkPosition& pos, uint16_t connectivity);
+    void erase(const ChunkPosition& pos);
+    void clear();
+    size_t size() const { return connectivity_.size(); }
+
+    /**
+     * Collect the chunks reachable from the camera, within radius chunks of its chunk
+     * on every axis and intersecting the frustum, in breadth-first (near to far) order.
+     * The camera's chunk is always included.
+     * @param frustum Camera-relative planes (Camera::getFrustum)
+     */
+    void traverse(const Frustum& frustum, const glm::vec3& cameraPos, int32_t radius,
+                  std::vector<ChunkPosition>& visible);
+
+private:
+    struct Step {
+        ChunkPosition pos;
+        int8_t entryFace;    // Face entered through (FaceUtils order), -1 for the camera chunk
+        uint8_t directions;  // Directions taken so far, one bit per face
+    };
+
+    uint16_t getConnectivity(const ChunkPosition& pos) const;
+
+    std::unordered_map<ChunkPosition, uint16_t, ChunkPositionHash> connectivity_;
+
+    // Visit marks for the (2 * radius + 1)^3 chunks around the camera, reused between frames
+    std::vector<uint32_t> visitStamps_;
+    int32_t stampRadius_ = -1;
+    uint32_t stamp_ = 0;
+    std::vector<Step> queue_;
+};
+
+} // namespace FarHorizon
@@ -3,6 +3,7 @@
 #include "BlockModel.hpp"
 #include "BlockRegistry.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 namespace FarHorizon {
 
@@ -346,6 +347,55 @@ void FaceCullingSystem::precacheAllShapes(const std::unordered_map<uint16_t, con
 
     spdlog::info("BlockShape cache built: {} full cubes, {} partial, {} empty (total: {})",
                  fullCubes, partialShapes, emptyShapes, shapeCache_.size());
+
+    uint16_t maxStateId = 0;
+    for (const auto& [stateId, model] : stateToModel) {
+        maxStateId = std::max(maxStateId, stateId);
+    }
+    buildDrawTable(stateToModel.empty() ? 0 : static_cast<size_t>(maxStateId) + 1);
+}
+
+void FaceCullingSystem::buildDrawTable(size_t stateCount) {
+    drawTable_.clear();
+    tableStateCount_ = 0;
+
+    if (stateCount > MAX_TABLE_STATES) {
+        spdlog::warn("{} BlockStates exceed the face culling table limit ({}), using per-face culling",
+                     stateCount, MAX_TABLE_STATES);
+        return;
+    }
+
+    // Resolve every shape once; IDs without a model use the same fallback as the mesher
+    std::vector<const BlockShape*> shapes(stateCount);
+    for (size_t stateId = 0; stateId < stateCount; stateId++) {
+        shapes[stateId] = &getBlockShape(BlockState(static_cast<uint16_t>(stateId)), nullptr);
+    }
+
+    static constexpr FaceDirection FACES[6] = {
+        FaceDirection::SOUTH, FaceDirection::NORTH, FaceDirection::WEST,
+        FaceDirection::EAST, FaceDirection::UP, FaceDirection::DOWN
+    };
+
+    std::vector<uint64_t> table((6 * stateCount * stateCount + 63) / 64, 0);
+    for (FaceDirection face : FACES) {
+        size_t faceBase = static_cast<size_t>(FaceUtils::toIndex(face)) * stateCount;
+        for (size_t current = 0; current < stateCount; current++) {
+            BlockState currentState(static_cast<uint16_t>(current));
+            for (size_t neighbor = 0; neighbor < stateCount; neighbor++) {
+                BlockState neighborState(static_cast<uint16_t>(neighbor));
+                if (shouldDrawFace(currentState, neighborState, face, *shapes[current], *shapes[neighbor])) {
+                    size_t bit = (faceBase + current) * stateCount + neighbor;
+                    table[bit >> 6] |= uint64_t(1) << (bit & 63);
+                }
+            }
+        }
+    }
+
+    drawTable_ = std::move(table);
+    tableStateCount_ = stateCount;
+
+    spdlog::info("Face culling table built for {} BlockStates ({} KiB)",
+                 stateCount, drawTable_.size() * sizeof(uint64_t) / 1024);
 }
 
 bool FaceCullingSystem::geometricComparison(
@@ -383,6 +433,8 @@ bool FaceCullingSystem::geometricComparison(
 void FaceCullingSystem::clearCache() {
     s_cache.clear();
     shapeCache_.clear();
+    drawTable_.clear();
+    tableStateCount_ = 0;
 }
 
 } // namespace FarHorizon
\ No newline at end of file
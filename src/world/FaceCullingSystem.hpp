@@ -9,6 +9,7 @@
 #include <list>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 namespace FarHorizon {
 
@@ -78,9 +79,23 @@ public:
     const BlockShape& getBlockShape(BlockState state, const BlockModel* model);
 
     // Pre-compute shapes for all BlockStates (call after block models are loaded)
-    // Takes a map of BlockState ID -> BlockModel* to eagerly compute all shapes
+    // Takes a map of BlockState ID -> BlockModel* to eagerly compute all shapes,
+    // then fills the state-pair draw table from them
     void precacheAllShapes(const std::unordered_map<uint16_t, const BlockModel*>& stateToModel);
 
+    // True if both states are covered by the precomputed draw table
+    bool hasDrawTableEntry(BlockState currentState, BlockState neighborState) const {
+        return currentState.id < tableStateCount_ && neighborState.id < tableStateCount_;
+    }
+
+    // shouldDrawFace() as a single bit lookup (check hasDrawTableEntry first)
+    // Read-only after precacheAllShapes, safe from any thread
+    bool lookupDrawFace(BlockState currentState, BlockState neighborState, FaceDirection face) const {
+        size_t bit = (static_cast<size_t>(FaceUtils::toIndex(face)) * tableStateCount_ + currentState.id)
+                   * tableStateCount_ + neighborState.id;
+        return (drawTable_[bit >> 6] >> (bit & 63)) & 1;
+    }
+
     // Clear all caches (useful for testing or after large changes)
     void clearCache();
 
@@ -99,6 +114,17 @@ private:
     // BlockShape cache: maps BlockState ID → BlockShape
     // Avoids recomputing shapes every frame (HUGE performance win)
     std::unordered_map<uint16_t, BlockShape> shapeCache_;
+
+    // Above this many states the table (6 * N² bits) is not built and every
+    // pair goes through shouldDrawFace (1024 states = 768 KiB)
+    static constexpr size_t MAX_TABLE_STATES = 1024;
+
+    // Draw bits for every (face, current, neighbor) with both IDs < tableStateCount_,
+    // bit index (face * N + current) * N + neighbor, face in FaceUtils::toIndex order
+    std::vector<uint64_t> drawTable_;
+    size_t tableStateCount_ = 0;
+
+    void buildDrawTable(size_t stateCount);
 };
 
 } // namespace FarHorizon
\ No newline at end of file
@@ -0,0 +1,385 @@
+#include "LightEngine.hpp"
+#include "BlockRegistry.hpp"
+#include <tracy/Tracy.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdlib>
+
+namespace FarHorizon {
+
+static constexpr uint8_t STATE_BLOCKS_LIGHT = 0x80;
+static constexpr uint8_t STATE_EMISSION_MASK = 0x0F;
+
+// Face neighbor offsets: west, east, down, up, north, south
+static constexpr int FACE_OFFSETS[6][3] = {
+    {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}
+};
+
+// Block range along one axis that borders the neighbor at offset d (-1, 0 or 1) on that axis
+static void getBorderRange(int d, uint32_t& lo, uint32_t& hi) {
+    lo = d > 0 ? CHUNK_SIZE - 1 : 0;
+    hi = d < 0 ? 0 : CHUNK_SIZE - 1;
+}
+
+// ===== ChunkLightData Implementation =====
+
+const std::shared_ptr<const ChunkLightData>& ChunkLightData::openSky() {
+    static const std::shared_ptr<const ChunkLightData> instance = [] {
+        auto light = std::make_shared<ChunkLightData>();
+        light->light_.fill(MAX_LIGHT);
+        return light;
+    }();
+    return instance;
+}
+
+const std::shared_ptr<const ChunkLightData>& ChunkLightData::dark() {
+    static const std::shared_ptr<const ChunkLightData> instance = std::make_shared<ChunkLightData>();
+    return instance;
+}
+
+const std::shared_ptr<const ChunkLightData>& ChunkLightData::solid() {
+    static const std::shared_ptr<const ChunkLightData> instance = [] {
+        auto light = std::make_shared<ChunkLightData>();
+        light->opaque_.fill(~uint64_t{0});
+        return light;
+    }();
+    return instance;
+}
+
+// ===== LightEngine Implementation =====
+
+void LightEngine::initialize(size_t stateCount) {
+    ZoneScoped;
+
+    stateLight_.assign(stateCount, 0);
+    size_t blockingCount = 0;
+    size_t emitterCount = 0;
+
+    for (size_t stateId = 0; stateId < stateCount; stateId++) {
+        BlockState state(static_cast<uint16_t>(stateId));
+        if (state.isAir()) {
+            continue;
+        }
+
+        Block* block = BlockRegistry::getBlock(state);
+        if (!block) {
+            continue;
+        }
+
+        uint8_t flags = std::min<uint8_t>(block->getLightEmission(state), ChunkLightData::MAX_LIGHT);
+        if (block->blocksLight(state)) {
+            flags |= STATE_BLOCKS_LIGHT;
+            blockingCount++;
+        }
+        if (flags & STATE_EMISSION_MASK) {
+            emitterCount++;
+        }
+        stateLight_[stateId] = flags;
+    }
+
+    spdlog::info("Light engine: {} states, {} block light, {} emit light", stateCount, blockingCount, emitterCount);
+}
+
+bool LightEngine::needsUpdate(const ChunkPosition& pos, uint32_t blockVersion) const {
+    const Shard& shard = getShard(pos);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(pos);
+    if (it == shard.entries.end()) {
+        return true;
+    }
+    const Entry& entry = it->second;
+    return entry.stale || !entry.light || entry.blockVersion != blockVersion;
+}
+
+bool LightEngine::hasLight(const ChunkPosition& pos) const {
+    const Shard& shard = getShard(pos);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(pos);
+    return it != shard.entries.end() && it->second.light != nullptr;
+}
+
+void LightEngine::markStale(const ChunkPosition& pos) {
+    Shard& shard = getShard(pos);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Entry& entry = shard.entries[pos];
+    entry.generation++;
+    entry.stale = true;
+}
+
+ChunkLightPtr LightEngine::getOrAssume(const ChunkPosition& pos, int dy) const {
+    const Shard& shard = getShard(pos);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(pos);
+        if (it != shard.entries.end() && it->second.light) {
+            return it->second.light;
+        }
+    }
+    return dy > 0 ? ChunkLightData::openSky() : ChunkLightData::dark();
+}
+
+ChunkLightNeighborhood LightEngine::getNeighborhood(const ChunkPosition& pos) const {
+    ChunkLightNeighborhood neighborhood;
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                neighborhood.lights[ChunkNeighborhood::getIndex(dx, dy, dz)] =
+                    getOrAssume(pos.getNeighbor(dx, dy, dz), dy);
+            }
+        }
+    }
+    return neighborhood;
+}
+
+ChunkLightPtr LightEngine::computeLight(const ChunkData& chunk, const std::array<ChunkLightPtr, 6>& faceNeighbors) const {
+    ZoneScoped;
+
+    // Computed in scratch space; only non-uniform results get their own allocation
+    thread_local ChunkLightData scratch;
+    ChunkLightData* result = &scratch;
+    result->opaque_.fill(0);
+
+    // Separate channels while propagating; packed into light_ at the end
+    std::array<uint8_t, CHUNK_VOLUME> sky{};
+    std::array<uint8_t, CHUNK_VOLUME> block{};
+    thread_local std::vector<uint16_t> skyQueue;
+    thread_local std::vector<uint16_t> blockQueue;
+    skyQueue.clear();
+    blockQueue.clear();
+
+    // Opacity and emitters: flags per palette entry, then one pass over the packed indices
+    const auto& states = chunk.getPalette().getStates();
+    thread_local std::vector<uint8_t> paletteFlags;
+    paletteFlags.resize(states.size());
+    uint8_t anyFlags = 0;
+    for (size_t i = 0; i < states.size(); i++) {
+        paletteFlags[i] = states[i] < stateLight_.size() ? stateLight_[states[i]] : 0;
+        anyFlags |= paletteFlags[i];
+    }
+
+    // A single light-blocking state: no seed or flood can enter, whatever the neighbors hold
+    if (states.size() == 1 && paletteFlags[0] == STATE_BLOCKS_LIGHT) {
+        return ChunkLightData::solid();
+    }
+
+    if (anyFlags != 0) {
+        const PackedBlockStorage& storage = chunk.getStorage();
+        for (uint32_t index = 0; index < CHUNK_VOLUME; index++) {
+            uint8_t flags = paletteFlags[storage.get(index)];
+            if (flags & STATE_BLOCKS_LIGHT) {
+                result->opaque_[index >> 6] |= uint64_t{1} << (index & 63);
+            }
+            if (uint8_t emission = flags & STATE_EMISSION_MASK) {
+                block[index] = emission;
+                blockQueue.push_back(static_cast<uint16_t>(index));
+            }
+        }
+    }
+
+    // Border seeds: light one block past each face, dropping by one on the way in.
+    // Full sky light from above enters unchanged.
+    for (int face = 0; face < 6; face++) {
+        const ChunkLightData& neighbor = *faceNeighbors[face];
+        const int* offset = FACE_OFFSETS[face];
+        const bool fromAbove = offset[1] > 0;
+
+        uint32_t xLo, xHi, yLo, yHi, zLo, zHi;
+        getBorderRange(offset[0], xLo, xHi);
+        getBorderRange(offset[1], yLo, yHi);
+        getBorderRange(offset[2], zLo, zHi);
+
+        for (uint32_t z = zLo; z <= zHi; z++) {
+            for (uint32_t y = yLo; y <= yHi; y++) {
+                for (uint32_t x = xLo; x <= xHi; x++) {
+                    uint32_t index = ChunkData::getBlockIndex(x, y, z);
+                    if (result->isOpaque(index)) {
+                        continue;
+                    }
+
+                    uint32_t neighborIndex = ChunkData::getBlockIndex(
+                        offset[0] != 0 ? CHUNK_SIZE - 1 - x : x,
+                        offset[1] != 0 ? CHUNK_SIZE - 1 - y : y,
+                        offset[2] != 0 ? CHUNK_SIZE - 1 - z : z);
+
+                    uint8_t neighborSky = neighbor.getSkyLight(neighborIndex);
+                    uint8_t skyLevel = (fromAbove && neighborSky == ChunkLightData::MAX_LIGHT)
+                        ? neighborSky : static_cast<uint8_t>(std::max(neighborSky - 1, 0));
+                    if (skyLevel > sky[index]) {
+                        sky[index] = skyLevel;
+                        skyQueue.push_back(static_cast<uint16_t>(index));
+                    }
+
+                    uint8_t neighborBlock = neighbor.getBlockLight(neighborIndex);
+                    if (neighborBlock > 1 && neighborBlock - 1 > block[index]) {
+                        block[index] = static_cast<uint8_t>(neighborBlock - 1);
+                        blockQueue.push_back(static_cast<uint16_t>(index));
+                    }
+                }
+            }
+        }
+    }
+
+    // Flood fill; levels only ever rise, so cells are re-queued at most 15 times
+    auto propagate = [&](std::array<uint8_t, CHUNK_VOLUME>& levels, std::vector<uint16_t>& queue, bool skyChannel) {
+        for (size_t head = 0; head < queue.size(); head++) {
+            uint32_t index = queue[head];
+            uint8_t level = levels[index];
+            if (level <= 1) {
+                continue;
+            }
+
+            uint32_t x = index % CHUNK_SIZE;
+            uint32_t y = (index / CHUNK_SIZE) % CHUNK_SIZE;
+            uint32_t z = index / (CHUNK_SIZE * CHUNK_SIZE);
+
+            for (int face = 0; face < 6; face++) {
+                const int* offset = FACE_OFFSETS[face];
+                int nx = static_cast<int>(x) + offset[0];
+                int ny = static_cast<int>(y) + offset[1];
+                int nz = static_cast<int>(z) + offset[2];
+                if (nx < 0 || ny < 0 || nz < 0 ||
+                    nx >= static_cast<int>(CHUNK_SIZE) || ny >= static_cast<int>(CHUNK_SIZE) || nz >= static_cast<int>(CHUNK_SIZE)) {
+                    continue;
+                }
+
+                uint32_t neighborIndex = ChunkData::getBlockIndex(nx, ny, nz);
+                if (result->isOpaque(neighborIndex)) {
+                    continue;
+                }
+
+                uint8_t next = (skyChannel && offset[1] < 0 && level == ChunkLightData::MAX_LIGHT)
+                    ? level : static_cast<uint8_t>(level - 1);
+                if (next > levels[neighborIndex]) {
+                    levels[neighborIndex] = next;
+                    queue.push_back(static_cast<uint16_t>(neighborIndex));
+                }
+            }
+        }
+    };
+
+    propagate(sky, skyQueue, true);
+    propagate(block, blockQueue, false);
+
+    for (uint32_t index = 0; index < CHUNK_VOLUME; index++) {
+        result->light_[index] = static_cast<uint8_t>(sky[index] | (block[index] << 4));
+    }
+
+    for (const ChunkLightPtr* shared : {&ChunkLightData::openSky(), &ChunkLightData::dark(), &ChunkLightData::solid()}) {
+        if (result->light_ == (*shared)->light_ && result->opaque_ == (*shared)->opaque_) {
+            return *shared;
+        }
+    }
+    return std::make_shared<const ChunkLightData>(*result);
+}
+
+LightEngine::UpdateResult LightEngine::update(const ChunkNeighborhood& chunks) {
+    ZoneScoped;
+
+    UpdateResult result;
+    const ChunkDataPtr& chunk = chunks.getCenter();
+    if (!chunk) {
+        return result;
+    }
+
+    const ChunkPosition& pos = chunk->getPosition();
+    Shard& shard = getShard(pos);
+
+    uint32_t generation;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        generation = shard.entries[pos].generation;
+    }
+
+    std::array<ChunkLightPtr, 6> faceNeighbors;
+    for (int face = 0; face < 6; face++) {
+        const int* offset = FACE_OFFSETS[face];
+        faceNeighbors[face] = getOrAssume(pos.getNeighbor(offset[0], offset[1], offset[2]), offset[1]);
+    }
+
+    ChunkLightPtr light = computeLight(*chunk, faceNeighbors);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Entry& entry = shard.entries[pos];
+
+    // What each neighbor saw of us so far: our previous light, or the stand-in it assumed
+    // Shared uniform instances compare by pointer
+    const ChunkLightData* previous = entry.light.get();
+    result.lightChanged = !previous || (previous != light.get() &&
+        (previous->light_ != light->light_ || previous->opaque_ != light->opaque_));
+
+    if (result.lightChanged) {
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if (dx == 0 && dy == 0 && dz == 0) {
+                        continue;
+                    }
+
+                    // The neighbor at (dx, dy, dz) sees us at (-dx, -dy, -dz): above it if dy < 0
+                    const ChunkLightData& seen = previous ? *previous
+                        : *(dy < 0 ? ChunkLightData::openSky() : ChunkLightData::dark());
+
+                    uint32_t xLo, xHi, yLo, yHi, zLo, zHi;
+                    getBorderRange(dx, xLo, xHi);
+                    getBorderRange(dy, yLo, yHi);
+                    getBorderRange(dz, zLo, zHi);
+
+                    bool lightDiffers = false;
+                    bool opacityDiffers = false;
+                    for (uint32_t z = zLo; z <= zHi && !lightDiffers; z++) {
+                        for (uint32_t y = yLo; y <= yHi && !lightDiffers; y++) {
+                            for (uint32_t x = xLo; x <= xHi; x++) {
+                                uint32_t index = ChunkData::getBlockIndex(x, y, z);
+                                if (seen.getPacked(index) != light->getPacked(index)) {
+                                    lightDiffers = true;
+                                    break;
+                                }
+                                opacityDiffers |= seen.isOpaque(index) != light->isOpaque(index);
+                            }
+                        }
+                    }
+
+                    size_t neighborIndex = ChunkNeighborhood::getIndex(dx, dy, dz);
+                    if (lightDiffers || opacityDiffers) {
+                        result.changedNeighbors |= 1u << neighborIndex;
+                    }
+                    // Only face neighbors read our levels when propagating
+                    if (lightDiffers && std::abs(dx) + std::abs(dy) + std::abs(dz) == 1) {
+                        result.relightNeighbors |= 1u << neighborIndex;
+                    }
+                }
+            }
+        }
+    }
+
+    entry.light = std::move(light);
+    entry.blockVersion = chunk->getVersion();
+    if (entry.generation == generation) {
+        entry.stale = false;
+    } else {
+        result.stillStale = true;
+    }
+    return result;
+}
+
+size_t LightEngine::evictOutside(const ChunkPosition& center, float radius) {
+    ZoneScoped;
+
+    size_t evicted = 0;
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        evicted += std::erase_if(shard.entries, [&](const auto& item) {
+            return item.first.distanceTo(center) > radius;
+        });
+    }
+    return evicted;
+}
+
+void LightEngine::clear() {
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries.clear();
+    }
+}
+
+} // namespace FarHorizon
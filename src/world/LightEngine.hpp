@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Chunk.hpp"
+#include "ChunkData.hpp"
+#include "ChunkStorage.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace FarHorizon {
+
+/**
+ * Immutable light levels for one chunk (published by LightEngine, read by the mesher).
+ *
+ * Each block stores two 4-bit channels in one byte: sky light (low nibble) and
+ * block light (high nibble). Light-blocking blocks are flagged separately and
+ * always hold 0.
+ *
+ * Uniform results (open sky, dark air, solid rock) are not allocated per chunk:
+ * they publish the shared instances below, so most of a loaded world costs no light memory.
+ */
+class ChunkLightData {
+public:
+    static constexpr uint8_t MAX_LIGHT = 15;
+
+    uint8_t getSkyLight(uint32_t index) const { return light_[index] & 0x0F; }
+    uint8_t getBlockLight(uint32_t index) const { return light_[index] >> 4; }
+    uint8_t getPacked(uint32_t index) const { return light_[index]; }
+    bool isOpaque(uint32_t index) const { return (opaque_[index >> 6] >> (index & 63)) & 1; }
+
+    // Full sky light, or no light at all, with nothing opaque. Also the stand-ins for chunks without published light
+    static const std::shared_ptr<const ChunkLightData>& openSky();
+    static const std::shared_ptr<const ChunkLightData>& dark();
+    // Every block opaque (and so unlit)
+    static const std::shared_ptr<const ChunkLightData>& solid();
+
+private:
+    friend class LightEngine;
+
+    std::array<uint8_t, CHUNK_VOLUME> light_{};
+    std::array<uint64_t, CHUNK_VOLUME / 64> opaque_{};
+};
+
+using ChunkLightPtr = std::shared_ptr<const ChunkLightData>;
+
+/**
+ * Light of a chunk and its 26 neighbors, indexed like ChunkNeighborhood.
+ * Never null: neighbors without published light use the LightEngine stand-ins.
+ */
+struct ChunkLightNeighborhood {
+    std::array<ChunkLightPtr, 27> lights;
+
+    const ChunkLightPtr& get(int dx, int dy, int dz) const { return lights[ChunkNeighborhood::getIndex(dx, dy, dz)]; }
+};
+
+/**
+ * Sky and block light propagation, run as a job stage before meshing.
+ *
+ * Each chunk is relit on its own: seeds come from its emitters and the border
+ * layers of its six face neighbors' published light, then a BFS flood-fill
+ * spreads them through the chunk (sky light of 15 travels straight down without
+ * falling off). Publishing compares against the previous light and reports which
+ * neighbors see a changed border, so ChunkManager relights/remeshes exactly those.
+ * Repeating this until nothing changes converges on the same result as a global
+ * flood fill, including after light sources are removed (light can't sustain
+ * itself around a loop since it drops by one per block).
+ *
+ * Until a neighbor publishes, chunks above read as open sky and all others as dark.
+ *
+ * Thread safety: all public methods are thread-safe. Different chunks relight
+ * fully in parallel; storage is sharded like ChunkStorage.
+ */
+class LightEngine {
+public:
+    static constexpr size_t NUM_SHARDS = 64;
+
+    LightEngine() = default;
+
+    // Non-copyable, non-movable (contains mutexes)
+    LightEngine(const LightEngine&) = delete;
+    LightEngine& operator=(const LightEngine&) = delete;
+
+    // Cache per-state opacity/emission from BlockRegistry (call before any update, single-threaded)
+    void initialize(size_t stateCount);
+
+    // True if the chunk has no light yet, was marked stale, or its blocks changed since it was lit
+    bool needsUpdate(const ChunkPosition& pos, uint32_t blockVersion) const;
+    bool hasLight(const ChunkPosition& pos) const;
+
+    // A neighbor's border changed: relight on the next update
+    void markStale(const ChunkPosition& pos);
+
+    struct UpdateResult {
+        bool lightChanged = false;     // Any level in the chunk itself changed
+        bool stillStale = false;       // Marked stale again while computing, run another update
+        uint32_t changedNeighbors = 0; // Bit per ChunkNeighborhood index whose shared border changed (remesh)
+        uint32_t relightNeighbors = 0; // Face neighbors whose incoming light changed (markStale + relight)
+    };
+
+    // Relight the center chunk of a neighborhood and publish the result
+    UpdateResult update(const ChunkNeighborhood& chunks);
+
+    // Published light around pos (stand-ins where missing)
+    ChunkLightNeighborhood getNeighborhood(const ChunkPosition& pos) const;
+
+    // Drop light for chunks further than radius from center
+    size_t evictOutside(const ChunkPosition& center, float radius);
+
+    void clear();
+
+private:
+    struct Entry {
+        ChunkLightPtr light;
+        uint32_t blockVersion = 0;  // ChunkData version the light was computed from
+        uint32_t generation = 0;    // Bumped by markStale
+        bool stale = true;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<ChunkPosition, Entry, ChunkPositionHash> entries;
+    };
+
+    std::array<Shard, NUM_SHARDS> shards_;
+
+    // Per blockstate: bit 7 = blocks light, low nibble = emission
+    std::vector<uint8_t> stateLight_;
+
+    Shard& getShard(const ChunkPosition& pos) { return shards_[ChunkPositionHash{}(pos) % NUM_SHARDS]; }
+    const Shard& getShard(const ChunkPosition& pos) const { return shards_[ChunkPositionHash{}(pos) % NUM_SHARDS]; }
+
+    // Published light, or the stand-in for a chunk at vertical offset dy from the reader
+    ChunkLightPtr getOrAssume(const ChunkPosition& pos, int dy) const;
+
+    // Shared instance when the result is uniform, else a new allocation
+    ChunkLightPtr computeLight(const ChunkData& chunk, const std::array<ChunkLightPtr, 6>& faceNeighbors) const;
+};
+
+} // namespace FarHorizon
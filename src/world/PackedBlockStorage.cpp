@@ -0,0 +1,53 @@
+#include "PackedBlockStorage.hpp"
+
+namespace FarHorizon {
+
+uint8_t PackedBlockStorage::getBitsForPaletteSize(size_t paletteSize) {
+    if (paletteSize <= 1) return 0;
+    if (paletteSize <= 2) return 1;
+    if (paletteSize <= 4) return 2;
+    if (paletteSize <= 16) return 4;
+    if (paletteSize <= 256) return 8;
+    return 16;
+}
+
+PackedBlockStorage::PackedBlockStorage(size_t paletteSize)
+    : bitsPerEntry_(getBitsForPaletteSize(paletteSize)) {
+    words_.assign(getWordCount(bitsPerEntry_), 0);
+}
+
+PackedBlockStorage::PackedBlockStorage(uint8_t bitsPerEntry, std::vector<uint64_t> words)
+    : words_(std::move(words))
+    , bitsPerEntry_(bitsPerEntry) {
+}
+
+void PackedBlockStorage::set(uint32_t index, uint16_t value) {
+    if (bitsPerEntry_ == 0) {
+        return;  // Only index 0 is representable
+    }
+    uint32_t bitIndex = index * bitsPerEntry_;
+    uint32_t shift = bitIndex & 63;
+    uint64_t& word = words_[bitIndex >> 6];
+    word = (word & ~(mask() << shift)) | ((static_cast<uint64_t>(value) & mask()) << shift);
+}
+
+void PackedBlockStorage::ensureCapacity(size_t paletteSize) {
+    uint8_t newBits = getBitsForPaletteSize(paletteSize);
+    if (newBits <= bitsPerEntry_) {
+        return;
+    }
+
+    PackedBlockStorage widened;
+    widened.bitsPerEntry_ = newBits;
+    widened.words_.assign(getWordCount(newBits), 0);
+
+    if (bitsPerEntry_ != 0) {
+        for (uint32_t i = 0; i < CHUNK_VOLUME; i++) {
+            widened.set(i, get(i));
+        }
+    }
+
+    *this = std::move(widened);
+}
+
+} // namespace FarHorizon
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Chunk.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace FarHorizon {
+
+/**
+ * Bit-packed array of CHUNK_VOLUME palette indices.
+ *
+ * Entries use 0, 1, 2, 4, 8 or 16 bits, picked from the palette size. Widths are
+ * powers of two, so an entry never straddles two 64-bit words.
+ * A 0-bit storage holds no words at all - every entry reads as index 0
+ * (single-value chunks such as all air or all stone).
+ */
+class PackedBlockStorage {
+public:
+    // 0-bit storage: every entry is index 0
+    PackedBlockStorage() = default;
+
+    // Zero-filled storage wide enough for paletteSize entries
+    explicit PackedBlockStorage(size_t paletteSize);
+
+    // Adopt already packed words (words.size() must equal getWordCount(bitsPerEntry))
+    PackedBlockStorage(uint8_t bitsPerEntry, std::vector<uint64_t> words);
+
+    uint16_t get(uint32_t index) const {
+        if (bitsPerEntry_ == 0) {
+            return 0;
+        }
+        uint32_t bitIndex = index * bitsPerEntry_;
+        uint64_t word = words_[bitIndex >> 6];
+        return static_cast<uint16_t>((word >> (bitIndex & 63)) & mask());
+    }
+
+    // value must fit the current width (see ensureCapacity)
+    void set(uint32_t index, uint16_t value);
+
+    /**
+     * Widen the storage (repacking every entry) if paletteSize no longer fits.
+     * Never narrows - use compact() for that.
+     */
+    void ensureCapacity(size_t paletteSize);
+
+    uint8_t getBitsPerEntry() const { return bitsPerEntry_; }
+    const std::vector<uint64_t>& getWords() const { return words_; }
+
+    // Heap bytes used by the packed words
+    size_t getMemoryUsage() const { return words_.size() * sizeof(uint64_t); }
+
+    // Smallest supported width that can index paletteSize entries
+    static uint8_t getBitsForPaletteSize(size_t paletteSize);
+
+    // Number of 64-bit words a storage of this width holds
+    static size_t getWordCount(uint8_t bitsPerEntry) {
+        return (static_cast<size_t>(CHUNK_VOLUME) * bitsPerEntry + 63) / 64;
+    }
+
+private:
+    std::vector<uint64_t> words_;
+    uint8_t bitsPerEntry_ = 0;
+
+    uint64_t mask() const { return (uint64_t{1} << bitsPerEntry_) - 1; }
+};
+
+} // namespace FarHorizon
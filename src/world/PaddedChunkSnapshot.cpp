@@ -0,0 +1,71 @@
+#include "PaddedChunkSnapshot.hpp"
+#include "FaceUtils.hpp"
+#include <tracy/Tracy.hpp>
+
+namespace FarHorizon {
+
+// Padded range along one axis covered by the neighbor at offset d, and the matching local start
+static void getPaddedRange(int d, int& lo, int& hi, int& localStart) {
+    if (d < 0) {
+        lo = hi = -1;
+        localStart = static_cast<int>(CHUNK_SIZE) - 1;
+    } else if (d > 0) {
+        lo = hi = static_cast<int>(CHUNK_SIZE);
+        localStart = 0;
+    } else {
+        lo = 0;
+        hi = static_cast<int>(CHUNK_SIZE) - 1;
+        localStart = 0;
+    }
+}
+
+int PaddedChunkSnapshot::getFaceStep(int faceIndex) {
+    return FaceUtils::FACE_DIRS[faceIndex][0] * STRIDES[0] +
+           FaceUtils::FACE_DIRS[faceIndex][1] * STRIDES[1] +
+           FaceUtils::FACE_DIRS[faceIndex][2] * STRIDES[2];
+}
+
+void PaddedChunkSnapshot::build(const ChunkNeighborhood& chunks) {
+    ZoneScoped;
+
+    // Interior: resolve the palette once, then one pass over the packed indices per row
+    const ChunkDataPtr& center = chunks.getCenter();
+    const auto& palette = center->getPalette().getStates();
+    const PackedBlockStorage& storage = center->getStorage();
+    for (uint32_t z = 0; z < CHUNK_SIZE; z++) {
+        for (uint32_t y = 0; y < CHUNK_SIZE; y++) {
+            uint32_t source = ChunkData::getBlockIndex(0, y, z);
+            uint16_t* row = &states[getIndex(0, static_cast<int>(y), static_cast<int>(z))];
+            for (uint32_t x = 0; x < CHUNK_SIZE; x++) {
+                row[x] = palette[storage.get(source + x)];
+            }
+        }
+    }
+
+    // Border: the touching face slice, edge row or corner block of each neighbor
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if (dx == 0 && dy == 0 && dz == 0) {
+                    continue;
+                }
+
+                int xLo, xHi, xLocal, yLo, yHi, yLocal, zLo, zHi, zLocal;
+                getPaddedRange(dx, xLo, xHi, xLocal);
+                getPaddedRange(dy, yLo, yHi, yLocal);
+                getPaddedRange(dz, zLo, zHi, zLocal);
+
+                const ChunkDataPtr& neighbor = chunks.get(dx, dy, dz);
+                for (int z = zLo, lz = zLocal; z <= zHi; z++, lz++) {
+                    for (int y = yLo, ly = yLocal; y <= yHi; y++, ly++) {
+                        for (int x = xLo, lx = xLocal; x <= xHi; x++, lx++) {
+                            states[getIndex(x, y, z)] = neighbor ? neighbor->getBlockState(lx, ly, lz).id : 0;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace FarHorizon
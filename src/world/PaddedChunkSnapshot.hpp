@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Chunk.hpp"
+#include "ChunkData.hpp"
+#include "ChunkStorage.hpp"
+#include <array>
+#include <cstdint>
+
+namespace FarHorizon {
+
+/**
+ * Blockstate IDs of one chunk plus a one-block border from all 26 neighbors,
+ * resolved into a contiguous 18^3 array (the meshing input stage).
+ *
+ * Coordinates run from -1 to 16 on each axis: index (x + 1) + (y + 1) * 18 + (z + 1) * 18 * 18.
+ * Any face, edge or corner neighbor of an interior block is then a fixed index
+ * offset away. Missing neighbor chunks read as air.
+ */
+struct PaddedChunkSnapshot {
+    static constexpr int SIZE = CHUNK_SIZE + 2;
+    static constexpr int VOLUME = SIZE * SIZE * SIZE;
+    static constexpr int STRIDES[3] = {1, SIZE, SIZE * SIZE};  // Index step along X, Y, Z
+
+    std::array<uint16_t, VOLUME> states;
+
+    void build(const ChunkNeighborhood& chunks);
+
+    static int getIndex(int x, int y, int z) {
+        return (x + 1) + (y + 1) * SIZE + (z + 1) * SIZE * SIZE;
+    }
+
+    // Index step to the neighbor in direction faceIndex (FaceUtils order)
+    static int getFaceStep(int faceIndex);
+
+    BlockState get(int x, int y, int z) const { return BlockState(states[getIndex(x, y, z)]); }
+};
+
+} // namespace FarHorizon
@@ -0,0 +1,271 @@
+#include "RegionFile.hpp"
+#include <spdlog/spdlog.h>
+#include <fmt/format.h>
+#include <tracy/Tracy.hpp>
+#include <zlib.h>
+#include <cstring>
+
+namespace FarHorizon {
+
+static constexpr uint32_t REGION_MAGIC = 0x47524846;  // "FHRG"
+static constexpr uint32_t REGION_FORMAT_VERSION = 1;
+static constexpr size_t HEADER_BYTES = 8 + RegionFile::CHUNKS_PER_REGION * 8;
+static constexpr uint32_t HEADER_SECTORS = static_cast<uint32_t>(
+    (HEADER_BYTES + RegionFile::SECTOR_SIZE - 1) / RegionFile::SECTOR_SIZE);
+
+// Upper bound for a decompressed chunk (16-bit palette + 16-bit indices, with slack)
+static constexpr uint32_t MAX_RAW_CHUNK_BYTES = 64 * 1024;
+
+static uint32_t getSectorCount(uint32_t length) {
+    return static_cast<uint32_t>((length + RegionFile::SECTOR_SIZE - 1) / RegionFile::SECTOR_SIZE);
+}
+
+RegionPosition RegionPosition::fromChunk(const ChunkPosition& pos) {
+    // Arithmetic shift floors for negative coordinates
+    return {pos.x >> 5, pos.y >> 5, pos.z >> 5};
+}
+
+std::filesystem::path RegionFile::getFileName(const RegionPosition& pos) {
+    return fmt::format("r.{}.{}.{}.fhr", pos.x, pos.y, pos.z);
+}
+
+uint32_t RegionFile::getEntryIndex(const ChunkPosition& pos) {
+    uint32_t x = static_cast<uint32_t>(pos.x) & (REGION_SIZE - 1);
+    uint32_t y = static_cast<uint32_t>(pos.y) & (REGION_SIZE - 1);
+    uint32_t z = static_cast<uint32_t>(pos.z) & (REGION_SIZE - 1);
+    return x + z * REGION_SIZE + y * REGION_SIZE * REGION_SIZE;
+}
+
+RegionFile::RegionFile(std::filesystem::path path)
+    : path_(std::move(path))
+    , entries_(CHUNKS_PER_REGION) {
+    if (!std::filesystem::exists(path_) && !createEmpty()) {
+        spdlog::error("RegionFile: failed to create {}", path_.string());
+        return;
+    }
+
+    if (!loadHeader()) {
+        spdlog::error("RegionFile: {} is not a valid region file", path_.string());
+        return;
+    }
+
+    file_.open(path_, std::ios::binary | std::ios::in | std::ios::out);
+    valid_ = file_.is_open();
+}
+
+bool RegionFile::createEmpty() {
+    std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    std::vector<char> header(static_cast<size_t>(HEADER_SECTORS) * SECTOR_SIZE, 0);
+    std::memcpy(header.data(), &REGION_MAGIC, sizeof(uint32_t));
+    std::memcpy(header.data() + 4, &REGION_FORMAT_VERSION, sizeof(uint32_t));
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    return static_cast<bool>(out);
+}
+
+bool RegionFile::loadHeader() {
+    if (!mapping_.open(path_) || mapping_.size() < HEADER_BYTES) {
+        return false;
+    }
+
+    const uint8_t* data = mapping_.data();
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    std::memcpy(&magic, data, sizeof(uint32_t));
+    std::memcpy(&version, data + 4, sizeof(uint32_t));
+    if (magic != REGION_MAGIC || version != REGION_FORMAT_VERSION) {
+        return false;
+    }
+
+    size_t fileSectors = (mapping_.size() + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    usedSectors_.assign(std::max<size_t>(fileSectors, HEADER_SECTORS), false);
+    setSectorsUsed(0, HEADER_SECTORS, true);
+
+    size_t dropped = 0;
+    for (uint32_t i = 0; i < CHUNKS_PER_REGION; i++) {
+        Entry entry;
+        std::memcpy(&entry, data + 8 + i * sizeof(Entry), sizeof(Entry));
+        if (entry.sector == 0) {
+            continue;
+        }
+
+        // Drop entries pointing into the header or past the end (truncated write)
+        uint64_t end = static_cast<uint64_t>(entry.sector) * SECTOR_SIZE + entry.length;
+        if (entry.sector < HEADER_SECTORS || entry.length == 0 || end > mapping_.size()) {
+            dropped++;
+            continue;
+        }
+
+        entries_[i] = entry;
+        setSectorsUsed(entry.sector, getSectorCount(entry.length), true);
+    }
+
+    if (dropped > 0) {
+        spdlog::warn("RegionFile: dropped {} corrupt chunk entries in {}", dropped, path_.string());
+    }
+    return true;
+}
+
+void RegionFile::setSectorsUsed(uint32_t first, uint32_t count, bool used) {
+    for (uint32_t i = first; i < first + count; i++) {
+        usedSectors_[i] = used;
+    }
+}
+
+uint32_t RegionFile::allocateSectors(uint32_t count) {
+    // First fit; a free run touching the end of the file is extended
+    uint32_t runStart = HEADER_SECTORS;
+    uint32_t runLength = 0;
+    for (uint32_t i = HEADER_SECTORS; i < usedSectors_.size(); i++) {
+        if (usedSectors_[i]) {
+            runStart = i + 1;
+            runLength = 0;
+        } else if (++runLength == count) {
+            break;
+        }
+    }
+
+    if (runStart + count > usedSectors_.size()) {
+        usedSectors_.resize(runStart + count, false);
+    }
+    setSectorsUsed(runStart, count, true);
+    return runStart;
+}
+
+ChunkDataPtr RegionFile::read(const ChunkPosition& pos) const {
+    ZoneScoped;
+
+    std::shared_lock lock(mutex_);
+    if (!valid_) {
+        return nullptr;
+    }
+
+    const Entry& entry = entries_[getEntryIndex(pos)];
+    if (entry.sector == 0 || !mapping_.isOpen()) {
+        return nullptr;
+    }
+
+    const uint8_t* blob = mapping_.data() + static_cast<size_t>(entry.sector) * SECTOR_SIZE;
+    uint32_t rawSize = 0;
+    std::memcpy(&rawSize, blob, sizeof(uint32_t));
+    if (entry.length <= sizeof(uint32_t) || rawSize > MAX_RAW_CHUNK_BYTES) {
+        return nullptr;
+    }
+
+    std::vector<uint8_t> raw(rawSize);
+    uLongf rawLength = rawSize;
+    int result = uncompress(raw.data(), &rawLength, blob + sizeof(uint32_t), entry.length - sizeof(uint32_t));
+    lock.unlock();
+
+    if (result != Z_OK || rawLength != rawSize) {
+        spdlog::warn("RegionFile: failed to inflate chunk ({}, {}, {}) in {}", pos.x, pos.y, pos.z, path_.string());
+        return nullptr;
+    }
+
+    ChunkDataPtr chunk = ChunkData::deserialize(pos, raw.data(), raw.size());
+    if (!chunk) {
+        spdlog::warn("RegionFile: malformed chunk ({}, {}, {}) in {}", pos.x, pos.y, pos.z, path_.string());
+    }
+    return chunk;
+}
+
+bool RegionFile::contains(const ChunkPosition& pos) const {
+    std::shared_lock lock(mutex_);
+    return valid_ && entries_[getEntryIndex(pos)].sector != 0;
+}
+
+bool RegionFile::write(const std::vector<std::pair<ChunkPosition, std::vector<uint8_t>>>& chunks) {
+    ZoneScoped;
+
+    std::unique_lock lock(mutex_);
+    if (!valid_) {
+        return false;
+    }
+
+    // The file grows below the mapping, so drop it for the duration of the batch
+    mapping_.close();
+
+    // Data first: old sectors stay reserved until the new headers are on disk,
+    // so no chunk in the batch can overwrite another chunk's readable copy
+    std::vector<std::pair<uint32_t, Entry>> written;
+    written.reserve(chunks.size());
+    bool ok = true;
+    for (const auto& [pos, blob] : chunks) {
+        uint32_t length = static_cast<uint32_t>(blob.size());
+        uint32_t sector = allocateSectors(getSectorCount(length));
+        written.emplace_back(getEntryIndex(pos), Entry{sector, length});
+
+        file_.seekp(static_cast<std::streamoff>(sector) * SECTOR_SIZE);
+        file_.write(reinterpret_cast<const char*>(blob.data()), length);
+        if (!file_) {
+            ok = false;
+            break;
+        }
+    }
+    ok = ok && file_.flush();
+
+    if (!ok) {
+        // Header untouched: every old entry is still valid on disk
+        for (const auto& [index, entry] : written) {
+            setSectorsUsed(entry.sector, getSectorCount(entry.length), false);
+        }
+        written.clear();
+    } else {
+        for (const auto& [index, entry] : written) {
+            file_.seekp(static_cast<std::streamoff>(8 + index * sizeof(Entry)));
+            file_.write(reinterpret_cast<const char*>(&entry), sizeof(Entry));
+            if (!file_) {
+                break;
+            }
+        }
+        ok = static_cast<bool>(file_.flush());
+    }
+
+    if (ok) {
+        for (const auto& [index, entry] : written) {
+            const Entry old = entries_[index];
+            if (old.sector != 0) {
+                setSectorsUsed(old.sector, getSectorCount(old.length), false);
+            }
+            entries_[index] = entry;
+        }
+    } else {
+        // A failed header write may have left old or new entries on disk; both
+        // sector runs stay reserved (until the next load) so either one reads back
+        spdlog::error("RegionFile: write failed for {}", path_.string());
+        file_.clear();
+    }
+
+    if (!mapping_.open(path_)) {
+        spdlog::error("RegionFile: failed to remap {}", path_.string());
+        valid_ = false;
+        return false;
+    }
+    return ok;
+}
+
+std::vector<uint8_t> RegionFile::compress(const ChunkData& chunk) {
+    ZoneScoped;
+
+    std::vector<uint8_t> raw = chunk.serialize();
+    uint32_t rawSize = static_cast<uint32_t>(raw.size());
+
+    // Blob: raw size, then the zlib stream
+    uLongf compressedLength = compressBound(static_cast<uLong>(raw.size()));
+    std::vector<uint8_t> blob(sizeof(uint32_t) + compressedLength);
+    std::memcpy(blob.data(), &rawSize, sizeof(uint32_t));
+    int result = compress2(blob.data() + sizeof(uint32_t), &compressedLength, raw.data(),
+                           static_cast<uLong>(raw.size()), Z_BEST_SPEED);
+    if (result != Z_OK) {
+        const ChunkPosition& pos = chunk.getPosition();
+        spdlog::error("RegionFile: failed to deflate chunk ({}, {}, {}): zlib error {}", pos.x, pos.y, pos.z, result);
+        return {};
+    }
+    blob.resize(sizeof(uint32_t) + compressedLength);
+    return blob;
+}
+
+} // namespace FarHorizon
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "ChunkData.hpp"
+#include "util/MappedFile.hpp"
+#include <filesystem>
+#include <fstream>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace FarHorizon {
+
+/**
+ * Position of a region (a 32x32x32 block of chunks).
+ */
+struct RegionPosition {
+    int32_t x, y, z;
+
+    bool operator==(const RegionPosition& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+
+    static RegionPosition fromChunk(const ChunkPosition& pos);
+};
+
+struct RegionPositionHash {
+    std::size_t operator()(const RegionPosition& pos) const {
+        return ChunkPositionHash{}({pos.x, pos.y, pos.z});
+    }
+};
+
+/**
+ * One region file on disk holding up to 32^3 zlib-compressed chunks.
+ *
+ * Layout:
+ * - Header: magic, format version, then one (sector, length) entry per chunk
+ * - Data: compressed chunks in 256-byte sectors; a rewritten chunk moves to
+ *   free sectors and its old sectors are reused later
+ *
+ * Reads go through a read-only memory mapping and may run on any thread.
+ * Writes are batched by the owner (RegionStorage's I/O thread): write()
+ * takes the exclusive lock once, unmaps, appends/rewrites and remaps.
+ */
+class RegionFile {
+public:
+    static constexpr int32_t REGION_SIZE = 32;
+    static constexpr uint32_t CHUNKS_PER_REGION = REGION_SIZE * REGION_SIZE * REGION_SIZE;
+    static constexpr size_t SECTOR_SIZE = 256;
+
+    // Opens the file, creating an empty region if it doesn't exist
+    explicit RegionFile(std::filesystem::path path);
+
+    RegionFile(const RegionFile&) = delete;
+    RegionFile& operator=(const RegionFile&) = delete;
+
+    bool isValid() const { return valid_; }
+
+    // Thread-safe. Returns nullptr if the chunk was never saved or fails to decode
+    ChunkDataPtr read(const ChunkPosition& pos) const;
+
+    // Thread-safe
+    bool contains(const ChunkPosition& pos) const;
+
+    /**
+     * Write a batch of compressed chunks (from compress()). Single-writer only.
+     * Entries switch to the new data only once it and the header are flushed.
+     * @return false if the file could not be written (chunks keep their old copy)
+     */
+    bool write(const std::vector<std::pair<ChunkPosition, std::vector<uint8_t>>>& chunks);
+
+    // Serialize + deflate a chunk into the on-disk blob format (empty on failure)
+    static std::vector<uint8_t> compress(const ChunkData& chunk);
+
+    static std::filesystem::path getFileName(const RegionPosition& pos);
+
+private:
+    struct Entry {
+        uint32_t sector = 0;  // 0 = not present
+        uint32_t length = 0;  // Blob length in bytes
+    };
+
+    std::filesystem::path path_;
+    std::fstream file_;
+    MappedFile mapping_;
+    std::vector<Entry> entries_;
+    std::vector<bool> usedSectors_;
+    bool valid_ = false;
+    mutable std::shared_mutex mutex_;
+
+    static uint32_t getEntryIndex(const ChunkPosition& pos);
+    bool createEmpty();
+    bool loadHeader();
+    uint32_t allocateSectors(uint32_t count);
+    void setSectorsUsed(uint32_t first, uint32_t count, bool used);
+};
+
+} // namespace FarHorizon
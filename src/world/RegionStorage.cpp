@@ -0,0 +1,230 @@
+#include "RegionStorage.hpp"
+#include <spdlog/spdlog.h>
+#include <tracy/Tracy.hpp>
+#include <chrono>
+#include <vector>
+
+namespace FarHorizon {
+
+// Writes are held back this long so unload sweeps land in the same region batch
+static constexpr auto WRITE_BATCH_DELAY = std::chrono::milliseconds(250);
+// ...unless this many chunks are already waiting
+static constexpr size_t MAX_WRITE_BATCH = 1024;
+// Open region files kept around (each holds a file handle and a mapping)
+static constexpr size_t MAX_OPEN_REGIONS = 64;
+
+RegionStorage::~RegionStorage() {
+    close();
+}
+
+bool RegionStorage::open(const std::filesystem::path& directory) {
+    close();
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        spdlog::error("RegionStorage: cannot create {}: {}", directory.string(), error.message());
+        return false;
+    }
+
+    directory_ = directory;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        stopping_ = false;
+        flushRequested_ = false;
+    }
+    ioThread_ = std::thread(&RegionStorage::ioWorker, this);
+    open_.store(true, std::memory_order_release);
+
+    spdlog::info("RegionStorage: saving chunks to {}", directory_.string());
+    return true;
+}
+
+void RegionStorage::close() {
+    if (!open_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    // The I/O thread drains the queue before exiting
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        stopping_ = true;
+    }
+    pendingCV_.notify_all();
+    if (ioThread_.joinable()) {
+        ioThread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(regionsMutex_);
+    regions_.clear();
+}
+
+std::shared_ptr<RegionFile> RegionStorage::getRegion(const RegionPosition& pos, bool create) {
+    std::lock_guard<std::mutex> lock(regionsMutex_);
+
+    auto it = regions_.find(pos);
+    if (it != regions_.end() && (it->second || !create)) {
+        return it->second;
+    }
+
+    std::filesystem::path path = directory_ / RegionFile::getFileName(pos);
+    std::shared_ptr<RegionFile> region;
+    if (create || std::filesystem::exists(path)) {
+        region = std::make_shared<RegionFile>(path);
+        if (!region->isValid()) {
+            region.reset();
+        }
+    }
+
+    // Evict an idle region when over budget. Regions still held by a reader or the
+    // writer stay, so there is never more than one RegionFile per file
+    if (it == regions_.end() && regions_.size() >= MAX_OPEN_REGIONS) {
+        for (auto evict = regions_.begin(); evict != regions_.end(); ++evict) {
+            if (evict->second.use_count() <= 1) {
+                regions_.erase(evict);
+                break;
+            }
+        }
+    }
+
+    regions_[pos] = region;
+    return region;
+}
+
+ChunkDataPtr RegionStorage::load(const ChunkPosition& pos) {
+    if (!isOpen()) {
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        auto it = pendingWrites_.find(pos);
+        if (it != pendingWrites_.end()) {
+            return it->second.chunk;
+        }
+    }
+
+    std::shared_ptr<RegionFile> region = getRegion(RegionPosition::fromChunk(pos), false);
+    return region ? region->read(pos) : nullptr;
+}
+
+void RegionStorage::save(ChunkDataPtr chunk, bool skipIfSaved) {
+    if (!chunk || !isOpen()) {
+        return;
+    }
+
+    size_t pending = 0;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        const ChunkPosition pos = chunk->getPosition();
+        if (skipIfSaved && pendingWrites_.contains(pos)) {
+            return;
+        }
+        pendingWrites_[pos] = {std::move(chunk), skipIfSaved};
+        queuedGeneration_++;
+        pending = pendingWrites_.size();
+    }
+
+    // The I/O thread batches on its own; only wake it early for a full batch
+    if (pending == 1 || pending >= MAX_WRITE_BATCH) {
+        pendingCV_.notify_one();
+    }
+}
+
+void RegionStorage::flush() {
+    if (!isOpen()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(pendingMutex_);
+    uint64_t target = queuedGeneration_;
+    flushRequested_ = true;
+    pendingCV_.notify_one();
+    writtenCV_.wait(lock, [&] { return writtenGeneration_ >= target || stopping_; });
+}
+
+size_t RegionStorage::getPendingWriteCount() const {
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    return pendingWrites_.size();
+}
+
+void RegionStorage::ioWorker() {
+    tracy::SetThreadName("RegionIO");
+
+    std::unique_lock<std::mutex> lock(pendingMutex_);
+    while (true) {
+        pendingCV_.wait(lock, [this] { return !pendingWrites_.empty() || stopping_ || flushRequested_; });
+
+        // Give unload sweeps a moment to queue the rest of their chunks
+        pendingCV_.wait_for(lock, WRITE_BATCH_DELAY, [this] {
+            return stopping_ || flushRequested_ || pendingWrites_.size() >= MAX_WRITE_BATCH;
+        });
+
+        if (pendingWrites_.empty()) {
+            writtenGeneration_ = queuedGeneration_;
+            flushRequested_ = false;
+            writtenCV_.notify_all();
+            if (stopping_) {
+                break;
+            }
+            continue;
+        }
+
+        // Entries stay in pendingWrites_ (and loadable) while being written
+        auto batch = pendingWrites_;
+        uint64_t batchGeneration = queuedGeneration_;
+        lock.unlock();
+
+        writeBatch(batch);
+
+        lock.lock();
+        for (const auto& [pos, write] : batch) {
+            auto it = pendingWrites_.find(pos);
+            if (it != pendingWrites_.end() && it->second.chunk == write.chunk) {
+                pendingWrites_.erase(it);
+            }
+        }
+        writtenGeneration_ = batchGeneration;
+        if (pendingWrites_.empty()) {
+            flushRequested_ = false;
+        }
+        writtenCV_.notify_all();
+    }
+}
+
+void RegionStorage::writeBatch(const PendingWriteMap& batch) {
+    ZoneScoped;
+
+    // Group by region so each file is locked and remapped once
+    std::unordered_map<RegionPosition, std::vector<std::pair<ChunkPosition, std::vector<uint8_t>>>, RegionPositionHash> byRegion;
+    size_t skipped = 0;
+    for (const auto& [pos, write] : batch) {
+        RegionPosition regionPos = RegionPosition::fromChunk(pos);
+        if (write.skipIfSaved) {
+            std::shared_ptr<RegionFile> region = getRegion(regionPos, false);
+            if (region && region->contains(pos)) {
+                skipped++;
+                continue;
+            }
+        }
+
+        // A chunk that fails to deflate is dropped; its previous copy on disk stays
+        std::vector<uint8_t> blob = RegionFile::compress(*write.chunk);
+        if (!blob.empty()) {
+            byRegion[regionPos].emplace_back(pos, std::move(blob));
+        }
+    }
+
+    for (const auto& [regionPos, chunks] : byRegion) {
+        std::shared_ptr<RegionFile> region = getRegion(regionPos, true);
+        if (!region || !region->write(chunks)) {
+            spdlog::error("RegionStorage: failed to write {} chunks to region ({}, {}, {})",
+                          chunks.size(), regionPos.x, regionPos.y, regionPos.z);
+        }
+    }
+
+    spdlog::debug("RegionStorage: wrote {} chunks to {} regions ({} already saved)",
+                  batch.size() - skipped, byRegion.size(), skipped);
+}
+
+} // namespace FarHorizon
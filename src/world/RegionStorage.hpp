@@ -0,0 +1,96 @@
+#pragma once
+
+#include "RegionFile.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace FarHorizon {
+
+/**
+ * On-disk chunk persistence built from region files.
+ *
+ * Design:
+ * - load() runs on the chunk job workers (memory-mapped read + inflate)
+ * - save() only queues the immutable ChunkData; a dedicated I/O thread
+ *   compresses queued chunks and writes them one region at a time
+ * - Queued-but-unwritten chunks are served straight from the queue,
+ *   so a chunk reloaded right after unloading never hits stale disk data
+ * - Only the I/O thread opens region files for writing or existence checks;
+ *   callers on the main thread never touch the disk
+ *
+ * Thread safety: all public methods are thread-safe.
+ */
+class RegionStorage {
+public:
+    RegionStorage() = default;
+    ~RegionStorage();
+
+    // Non-copyable, non-movable (contains mutexes and a thread)
+    RegionStorage(const RegionStorage&) = delete;
+    RegionStorage& operator=(const RegionStorage&) = delete;
+
+    /**
+     * Start persisting to directory (created if missing).
+     * Closes the previously opened world first.
+     */
+    bool open(const std::filesystem::path& directory);
+
+    // Write everything queued, stop the I/O thread and close all region files
+    void close();
+
+    bool isOpen() const { return open_.load(std::memory_order_acquire); }
+
+    /**
+     * Load a saved chunk. Returns nullptr if it was never saved (or on read errors).
+     */
+    ChunkDataPtr load(const ChunkPosition& pos);
+
+    /**
+     * Queue a chunk for writing (a later save of the same position replaces it).
+     * @param skipIfSaved Only write it if the position is neither queued nor on
+     *        disk yet; the disk check runs on the I/O thread
+     */
+    void save(ChunkDataPtr chunk, bool skipIfSaved = false);
+
+    // Block until everything queued so far has been written
+    void flush();
+
+    size_t getPendingWriteCount() const;
+
+private:
+    std::filesystem::path directory_;
+    std::atomic<bool> open_{false};
+
+    // Open region files by position; nullptr caches "no file on disk yet"
+    std::unordered_map<RegionPosition, std::shared_ptr<RegionFile>, RegionPositionHash> regions_;
+    std::mutex regionsMutex_;
+
+    struct PendingWrite {
+        ChunkDataPtr chunk;
+        bool skipIfSaved = false;
+    };
+    using PendingWriteMap = std::unordered_map<ChunkPosition, PendingWrite, ChunkPositionHash>;
+
+    // Chunks waiting for the I/O thread (stay readable until written)
+    PendingWriteMap pendingWrites_;
+    mutable std::mutex pendingMutex_;
+    std::condition_variable pendingCV_;
+    std::condition_variable writtenCV_;
+    uint64_t queuedGeneration_ = 0;   // Bumped on every save()
+    uint64_t writtenGeneration_ = 0;  // Highest generation fully written
+    bool flushRequested_ = false;
+    bool stopping_ = false;
+
+    std::thread ioThread_;
+
+    std::shared_ptr<RegionFile> getRegion(const RegionPosition& pos, bool create);
+    void ioWorker();
+    void writeBatch(const PendingWriteMap& batch);
+};
+
+} // namespace FarHorizon
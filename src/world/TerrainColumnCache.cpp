@@ -0,0 +1,99 @@
+#include "TerrainColumnCache.hpp"
+#include <FastNoise/FastNoise.h>
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace FarHorizon {
+
+// Static noise generator for terrain
+static FastNoise::SmartNode<> getTerrainNoise() {
+    static auto noise = FastNoise::New<FastNoise::OpenSimplex2>();
+    return noise;
+}
+
+TerrainColumn TerrainColumn::compute(int32_t chunkX, int32_t chunkZ) {
+    ZoneScoped;
+
+    static auto noise = getTerrainNoise();
+
+    // Batch generate noise for the entire chunk's X/Z plane (SIMD optimized)
+    std::array<float, CHUNK_SIZE * CHUNK_SIZE> noiseOutput;
+    constexpr float frequency = 0.02f;
+    noise->GenUniformGrid2D(
+        noiseOutput.data(),
+        chunkX * static_cast<int32_t>(CHUNK_SIZE),
+        chunkZ * static_cast<int32_t>(CHUNK_SIZE),
+        CHUNK_SIZE, CHUNK_SIZE,
+        frequency, 1337
+    );
+
+    TerrainColumn column;
+    column.minHeight = INT32_MAX;
+    column.maxHeight = INT32_MIN;
+    for (size_t i = 0; i < noiseOutput.size(); i++) {
+        int32_t height = static_cast<int32_t>((noiseOutput[i] + 1.0f) * 32.0f);
+        column.heights[i] = height;
+        column.minHeight = std::min(column.minHeight, height);
+        column.maxHeight = std::max(column.maxHeight, height);
+    }
+    return column;
+}
+
+TerrainColumnPtr TerrainColumnCache::getColumn(int32_t chunkX, int32_t chunkZ) {
+    int64_t key = ChunkPosition::asLong(chunkX, chunkZ);
+    Shard& shard = getShard(key);
+
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.columns.find(key);
+        if (it != shard.columns.end()) {
+            return it->second;
+        }
+    }
+
+    // Compute outside the lock; a concurrent duplicate is harmless
+    auto column = std::make_shared<const TerrainColumn>(TerrainColumn::compute(chunkX, chunkZ));
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto [it, inserted] = shard.columns.try_emplace(key, std::move(column));
+    return it->second;
+}
+
+size_t TerrainColumnCache::evictOutside(int32_t centerX, int32_t centerZ, float radius) {
+    ZoneScoped;
+
+    size_t evicted = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.columns.begin(); it != shard.columns.end();) {
+            int32_t dx = static_cast<int32_t>(it->first) - centerX;
+            int32_t dz = static_cast<int32_t>(it->first >> 32) - centerZ;
+            if (static_cast<float>(dx * dx + dz * dz) > radius * radius) {
+                it = shard.columns.erase(it);
+                evicted++;
+            } else {
+                ++it;
+            }
+        }
+    }
+    return evicted;
+}
+
+void TerrainColumnCache::clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.columns.clear();
+    }
+}
+
+size_t TerrainColumnCache::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.columns.size();
+    }
+    return total;
+}
+
+} // namespace FarHorizon
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Chunk.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace FarHorizon {
+
+/**
+ * Heightmap and surface bounds for one 16x16 chunk column.
+ * Shared by every chunk in the column, so the 2D noise runs once per column.
+ */
+struct TerrainColumn {
+    std::array<int32_t, CHUNK_SIZE * CHUNK_SIZE> heights;  // Surface block Y, indexed x + z * 16
+    int32_t minHeight = 0;
+    int32_t maxHeight = 0;
+
+    int32_t getHeight(uint32_t x, uint32_t z) const { return heights[x + z * CHUNK_SIZE]; }
+
+    // Evaluate the terrain noise for a column (no caching)
+    static TerrainColumn compute(int32_t chunkX, int32_t chunkZ);
+};
+
+using TerrainColumnPtr = std::shared_ptr<const TerrainColumn>;
+
+/**
+ * Concurrent (x, z) -> TerrainColumn cache used by chunk generation.
+ *
+ * Sharded like ChunkStorage; two workers racing on the same missing column
+ * both compute it and the first insert wins (columns are deterministic).
+ * ChunkManager evicts columns that left the load radius.
+ *
+ * Thread safety: all public methods are thread-safe.
+ */
+class TerrainColumnCache {
+public:
+    static constexpr size_t NUM_SHARDS = 16;
+
+    TerrainColumnCache() = default;
+
+    // Non-copyable, non-movable (contains mutexes)
+    TerrainColumnCache(const TerrainColumnCache&) = delete;
+    TerrainColumnCache& operator=(const TerrainColumnCache&) = delete;
+
+    // Cached column, computed on first use
+    TerrainColumnPtr getColumn(int32_t chunkX, int32_t chunkZ);
+
+    // Drop columns whose horizontal distance to (centerX, centerZ) exceeds radius
+    size_t evictOutside(int32_t centerX, int32_t centerZ, float radius);
+
+    void clear();
+    size_t size() const;
+
+private:
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<int64_t, TerrainColumnPtr> columns;  // Key: ChunkPosition::asLong(x, z)
+    };
+
+    std::array<Shard, NUM_SHARDS> shards_;
+
+    Shard& getShard(int64_t key) {
+        return shards_[ChunkPositionHash{}({static_cast<int32_t>(key), 0, static_cast<int32_t>(key >> 32)}) % NUM_SHARDS];
+    }
+};
+
+} // namespace FarHorizon
@@ -0,0 +1,166 @@
+#include "TerrainGenerator.hpp"
+#include "BlockRegistry.hpp"
+#include <FastNoise/FastNoise.h>
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FARHORIZON_TERRAIN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace FarHorizon {
+
+// ===== DensityTerrainGenerator =====
+
+// Noise frequency in blocks^-1 (the lattice call is scaled by CELL_SIZE)
+static constexpr float NOISE_FREQUENCY = 0.015f;
+
+// Density gradient: +1 every HEIGHT_FALLOFF blocks below BASE_HEIGHT. Noise is in [-1, 1],
+// so terrain is always solid below BASE_HEIGHT - HEIGHT_FALLOFF and always air above BASE_HEIGHT + HEIGHT_FALLOFF
+static constexpr float BASE_HEIGHT = 32.0f;
+static constexpr float HEIGHT_FALLOFF = 24.0f;
+
+static constexpr uint32_t PLANE_SIZE = CHUNK_SIZE * CHUNK_SIZE;
+
+// Floats per SSE2 register; rows and planes are whole multiples of it
+static constexpr uint32_t LANES = 4;
+static_assert(CHUNK_SIZE % LANES == 0);
+
+static const FastNoise::SmartNode<>& getDensityNoise() {
+    static FastNoise::SmartNode<> noise = FastNoise::New<FastNoise::OpenSimplex2>();
+    return noise;
+}
+
+// out[i] = a[i] + (b[i] - a[i]) * t for count floats (a multiple of LANES)
+static void lerpRows(const float* a, const float* b, float t, float* out, uint32_t count) {
+#ifdef FARHORIZON_TERRAIN_SSE2
+    const __m128 weight = _mm_set1_ps(t);
+    for (uint32_t i = 0; i < count; i += LANES) {
+        __m128 va = _mm_loadu_ps(a + i);
+        __m128 vb = _mm_loadu_ps(b + i);
+        _mm_storeu_ps(out + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), weight)));
+    }
+#else
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = a[i] + (b[i] - a[i]) * t;
+    }
+#endif
+}
+
+DensityTerrainGenerator::DensityTerrainGenerator(int seed)
+    : seed_(seed) {
+}
+
+std::shared_ptr<const ChunkData> DensityTerrainGenerator::generate(const ChunkPosition& position) {
+    ZoneScoped;
+
+    const auto& noise = getDensityNoise();
+
+    // One batched call for all lattice corners (FastNoise order: x fastest, then y, then z)
+    std::array<float, LATTICE_POINTS * LATTICE_POINTS * LATTICE_POINTS> lattice;
+    noise->GenUniformGrid3D(
+        lattice.data(),
+        position.x * static_cast<int32_t>(LATTICE_CELLS),
+        position.y * static_cast<int32_t>(LATTICE_CELLS),
+        position.z * static_cast<int32_t>(LATTICE_CELLS),
+        LATTICE_POINTS, LATTICE_POINTS, LATTICE_POINTS,
+        NOISE_FREQUENCY * CELL_SIZE, seed_
+    );
+
+    // Add the height gradient per lattice row and classify the chunk
+    int32_t chunkBottom = position.y * static_cast<int32_t>(CHUNK_SIZE);
+    bool anySolid = false;
+    bool allSolid = true;
+    for (uint32_t z = 0; z < LATTICE_POINTS; z++) {
+        for (uint32_t y = 0; y < LATTICE_POINTS; y++) {
+            float worldY = static_cast<float>(chunkBottom + static_cast<int32_t>(y * CELL_SIZE));
+            float gradient = (BASE_HEIGHT - worldY) / HEIGHT_FALLOFF;
+            for (uint32_t x = 0; x < LATTICE_POINTS; x++) {
+                float& density = lattice[x + (y + z * LATTICE_POINTS) * LATTICE_POINTS];
+                density += gradient;
+                anySolid |= density > 0.0f;
+                allSolid &= density > 0.0f;
+            }
+        }
+    }
+
+    // The top lattice row is the block above the chunk, so an all-solid lattice has no surface
+    if (!anySolid) {
+        return ChunkData::uniform(position, BlockState(BlockRegistry::AIR->getDefaultState().id));
+    }
+    if (allSolid) {
+        return ChunkData::uniform(position, BlockState(BlockRegistry::STONE->getDefaultState().id));
+    }
+
+    // Trilinear interpolation, one axis at a time, four blocks per step with SSE2
+    // (scalar fallback on other targets; both give the same floats)
+
+    // X: lattice rows -> 16 blocks, [latticeZ][latticeY][x]. A lattice cell spans one register
+    static_assert(CELL_SIZE == LANES);
+    std::array<float, LATTICE_POINTS * LATTICE_POINTS * CHUNK_SIZE> rowsX;
+#ifdef FARHORIZON_TERRAIN_SSE2
+    const __m128 steps = _mm_setr_ps(0.0f / CELL_SIZE, 1.0f / CELL_SIZE, 2.0f / CELL_SIZE, 3.0f / CELL_SIZE);
+#endif
+    for (uint32_t row = 0; row < LATTICE_POINTS * LATTICE_POINTS; row++) {
+        const float* corners = &lattice[row * LATTICE_POINTS];
+        for (uint32_t cell = 0; cell < LATTICE_CELLS; cell++) {
+            float* out = &rowsX[row * CHUNK_SIZE + cell * CELL_SIZE];
+#ifdef FARHORIZON_TERRAIN_SSE2
+            __m128 start = _mm_set1_ps(corners[cell]);
+            __m128 delta = _mm_set1_ps(corners[cell + 1] - corners[cell]);
+            _mm_storeu_ps(out, _mm_add_ps(start, _mm_mul_ps(delta, steps)));
+#else
+            for (uint32_t i = 0; i < CELL_SIZE; i++) {
+                out[i] = corners[cell] + (corners[cell + 1] - corners[cell]) * (static_cast<float>(i) / CELL_SIZE);
+            }
+#endif
+        }
+    }
+
+    // Z: -> [latticeY][z][x] planes
+    std::array<float, LATTICE_POINTS * PLANE_SIZE> planes;
+    for (uint32_t ly = 0; ly < LATTICE_POINTS; ly++) {
+        for (uint32_t z = 0; z < CHUNK_SIZE; z++) {
+            uint32_t cell = z / CELL_SIZE;
+            float t = static_cast<float>(z % CELL_SIZE) / CELL_SIZE;
+            lerpRows(&rowsX[(ly + cell * LATTICE_POINTS) * CHUNK_SIZE],
+                     &rowsX[(ly + (cell + 1) * LATTICE_POINTS) * CHUNK_SIZE],
+                     t, &planes[ly * PLANE_SIZE + z * CHUNK_SIZE], CHUNK_SIZE);
+        }
+    }
+
+    // Y: -> [y][z][x] for y in 0..16 (row 16 is the block above, for surface rules)
+    std::array<float, (CHUNK_SIZE + 1) * PLANE_SIZE> density;
+    for (uint32_t y = 0; y <= CHUNK_SIZE; y++) {
+        uint32_t cell = std::min(y / CELL_SIZE, LATTICE_CELLS - 1);
+        float t = static_cast<float>(y - cell * CELL_SIZE) / CELL_SIZE;
+        lerpRows(&planes[cell * PLANE_SIZE], &planes[(cell + 1) * PLANE_SIZE], t, &density[y * PLANE_SIZE],
+                 PLANE_SIZE);
+    }
+
+    // Surface rules
+    uint16_t airState = BlockRegistry::AIR->getDefaultState().id;
+    uint16_t stoneState = BlockRegistry::STONE->getDefaultState().id;
+    uint16_t grassState = BlockRegistry::GRASS_BLOCK->getDefaultState().id;
+
+    std::array<uint16_t, CHUNK_VOLUME> states;
+    for (uint32_t z = 0; z < CHUNK_SIZE; z++) {
+        for (uint32_t y = 0; y < CHUNK_SIZE; y++) {
+            const float* current = &density[y * PLANE_SIZE + z * CHUNK_SIZE];
+            const float* above = current + PLANE_SIZE;
+            for (uint32_t x = 0; x < CHUNK_SIZE; x++) {
+                uint16_t state = airState;
+                if (current[x] > 0.0f) {
+                    state = above[x] > 0.0f ? stoneState : grassState;
+                }
+                states[ChunkData::getBlockIndex(x, y, z)] = state;
+            }
+        }
+    }
+
+    return ChunkData::fromStateIds(position, states.data(), 0);  // Initial version
+}
+
+} // namespace FarHorizon
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Chunk.hpp"
+#include "ChunkData.hpp"
+#include "TerrainColumnCache.hpp"
+#include <cstdint>
+#include <memory>
+
+namespace FarHorizon {
+
+/**
+ * Pluggable terrain source used by the chunk job workers when a chunk is
+ * neither loaded nor saved on disk.
+ *
+ * Thread safety: generate() is called concurrently from every worker.
+ */
+class TerrainGenerator {
+public:
+    virtual ~TerrainGenerator() = default;
+
+    virtual const char* getName() const = 0;
+
+    // Produce the initial (version 0) contents of a chunk. Must be deterministic per position
+    virtual std::shared_ptr<const ChunkData> generate(const ChunkPosition& position) = 0;
+
+    // Drop cached per-column data further than radius chunks from (centerX, centerZ)
+    virtual void evictOutside(int32_t centerX, int32_t centerZ, float radius) {}
+
+    // Drop all cached data (world cleared)
+    virtual void clearCache() {}
+};
+
+/**
+ * The original 2D heightfield (ChunkData::generate) with a shared column cache.
+ */
+class HeightmapTerrainGenerator : public TerrainGenerator {
+public:
+    const char* getName() const override { return "heightmap"; }
+
+    std::shared_ptr<const ChunkData> generate(const ChunkPosition& position) override {
+        return ChunkData::generate(position, &columns_);
+    }
+
+    void evictOutside(int32_t centerX, int32_t centerZ, float radius) override {
+        columns_.evictOutside(centerX, centerZ, radius);
+    }
+
+    void clearCache() override { columns_.clear(); }
+
+private:
+    TerrainColumnCache columns_;
+};
+
+/**
+ * 3D density terrain with overhangs and caves.
+ *
+ * Density = 3D noise + height gradient; a block is solid where density > 0.
+ * Noise is sampled once per chunk on a coarse lattice (one corner every
+ * CELL_SIZE blocks, 5x5x5 points) with a single GenUniformGrid3D call, then
+ * trilinearly interpolated to every block. Lattice corners sit on world
+ * coordinates, so neighboring chunks agree on their shared faces.
+ *
+ * Surface rules: solid blocks with a non-solid block above are grass, the rest stone.
+ * Chunks whose lattice is entirely solid or entirely empty are emitted as
+ * uniform without interpolation (interpolated values never leave the corner range).
+ */
+class DensityTerrainGenerator : public TerrainGenerator {
+public:
+    static constexpr uint32_t CELL_SIZE = 4;
+    static constexpr uint32_t LATTICE_CELLS = CHUNK_SIZE / CELL_SIZE;
+    static constexpr uint32_t LATTICE_POINTS = LATTICE_CELLS + 1;
+
+    explicit DensityTerrainGenerator(int seed = 1337);
+
+    const char* getName() const override { return "density"; }
+
+    std::shared_ptr<const ChunkData> generate(const ChunkPosition& position) override;
+
+private:
+    int seed_;
+};
+
+} // namespace FarHorizon
@@ -0,0 +1,165 @@
+#include "TestHarness.hpp"
+#include "util/Frustum.hpp"
+#include "world/ChunkCuller.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+
+using namespace FarHorizon;
+
+// 90° square perspective looking down -Z from the origin, like Camera::getFrustum (camera-relative)
+static Frustum makeFrustum(const glm::vec3& forward = glm::vec3(0.0f, 0.0f, -1.0f)) {
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.5f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), forward, glm::vec3(0.0f, 1.0f, 0.0f));
+    return Frustum::fromMatrix(projection * view);
+}
+
+static float planeDistance(const Frustum& frustum, int plane, const glm::vec3& point) {
+    const glm::vec4& p = frustum.getPlane(plane);
+    return glm::dot(glm::vec3(p), point) + p.w;
+}
+
+// Run both culler paths and require identical output
+static std::vector<uint32_t> cullBoth(ChunkCuller& culler, const Frustum& frustum, const glm::vec3& cameraPos,
+                                      float maxDistance) {
+    std::vector<uint32_t> simd;
+    std::vector<uint32_t> scalar;
+    culler.cull(frustum, cameraPos, maxDistance, simd);
+    culler.cullScalar(frustum, cameraPos, maxDistance, scalar);
+    CHECK(simd == scalar);
+    return simd;
+}
+
+TEST_CASE("Frustum: planes of the identity matrix are the clip cube faces") {
+    Frustum frustum = Frustum::fromMatrix(glm::mat4(1.0f));
+    CHECK(frustum.getPlane(Frustum::Left) == glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+    CHECK(frustum.getPlane(Frustum::Right) == glm::vec4(-1.0f, 0.0f, 0.0f, 1.0f));
+    CHECK(frustum.getPlane(Frustum::Bottom) == glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+    CHECK(frustum.getPlane(Frustum::Top) == glm::vec4(0.0f, -1.0f, 0.0f, 1.0f));
+    CHECK(frustum.getPlane(Frustum::Near) == glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+    CHECK(frustum.getPlane(Frustum::Far) == glm::vec4(0.0f, 0.0f, -1.0f, 1.0f));
+}
+
+TEST_CASE("Frustum: perspective planes face inward") {
+    Frustum frustum = makeFrustum();
+
+    // A point ahead of the camera is inside every plane
+    for (int plane = 0; plane < Frustum::PLANE_COUNT; plane++) {
+        CHECK(planeDistance(frustum, plane, glm::vec3(0.0f, 0.0f, -10.0f)) > 0.0f);
+    }
+
+    // Each of these lies outside exactly the named plane
+    CHECK(planeDistance(frustum, Frustum::Left, glm::vec3(-20.0f, 0.0f, -10.0f)) < 0.0f);
+    CHECK(planeDistance(frustum, Frustum::Right, glm::vec3(20.0f, 0.0f, -10.0f)) < 0.0f);
+    CHECK(planeDistance(frustum, Frustum::Bottom, glm::vec3(0.0f, -20.0f, -10.0f)) < 0.0f);
+    CHECK(planeDistance(frustum, Frustum::Top, glm::vec3(0.0f, 20.0f, -10.0f)) < 0.0f);
+    CHECK(planeDistance(frustum, Frustum::Near, glm::vec3(0.0f, 0.0f, -0.25f)) < 0.0f);
+    CHECK(planeDistance(frustum, Frustum::Far, glm::vec3(0.0f, 0.0f, -150.0f)) < 0.0f);
+    CHECK(planeDistance(frustum, Frustum::Right, glm::vec3(-20.0f, 0.0f, -10.0f)) > 0.0f);
+    CHECK(planeDistance(frustum, Frustum::Top, glm::vec3(0.0f, -20.0f, -10.0f)) > 0.0f);
+
+    // The 90° side planes pass through x = ±z
+    CHECK(std::abs(planeDistance(frustum, Frustum::Left, glm::vec3(-10.0f, 0.0f, -10.0f))) < 1e-4f);
+    CHECK(std::abs(planeDistance(frustum, Frustum::Top, glm::vec3(0.0f, 10.0f, -10.0f))) < 1e-4f);
+}
+
+TEST_CASE("Frustum: boxes are rejected only when fully outside one plane") {
+    Frustum frustum = makeFrustum();
+    CHECK(frustum.intersectsBox(glm::vec3(-1.0f, -1.0f, -11.0f), glm::vec3(1.0f, 1.0f, -9.0f)));
+    CHECK(!frustum.intersectsBox(glm::vec3(-1.0f, -1.0f, 1.0f), glm::vec3(1.0f, 1.0f, 3.0f)));
+    CHECK(!frustum.intersectsBox(glm::vec3(-30.0f, -1.0f, -11.0f), glm::vec3(-20.0f, 1.0f, -9.0f)));
+
+    // Straddling the left plane, and containing the camera
+    CHECK(frustum.intersectsBox(glm::vec3(-15.0f, -1.0f, -11.0f), glm::vec3(-5.0f, 1.0f, -9.0f)));
+    CHECK(frustum.intersectsBox(glm::vec3(-1.0f), glm::vec3(1.0f)));
+}
+
+TEST_CASE("ChunkCuller: SSE2 and scalar paths agree") {
+    ChunkCuller culler;
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int> coordinate(-8, 7);
+
+    // 16-block chunks around the camera; 1001 is not a multiple of the SIMD width
+    culler.resize(1001);
+    for (size_t slot = 0; slot < culler.size(); slot++) {
+        glm::ivec3 min(coordinate(random) * 16, coordinate(random) * 16, coordinate(random) * 16);
+        culler.setBounds(slot, min, min + glm::ivec3(16));
+    }
+
+    const glm::vec3 forwards[] = {glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(1.0f, -0.5f, 0.25f),
+                                  glm::vec3(-0.3f, 0.8f, 0.5f)};
+    for (const glm::vec3& forward : forwards) {
+        Frustum frustum = makeFrustum(forward);
+        std::vector<uint32_t> visible = cullBoth(culler, frustum, glm::vec3(3.25f, -7.5f, 12.75f), 96.0f);
+        CHECK(!visible.empty());
+        CHECK(visible.size() < culler.size());
+    }
+
+    // Far from the origin the integer split keeps the boxes exact
+    for (size_t slot = 0; slot < culler.size(); slot++) {
+        glm::ivec3 min(20000000 + coordinate(random) * 16, coordinate(random) * 16, -20000000 + coordinate(random) * 16);
+        culler.setBounds(slot, min, min + glm::ivec3(16));
+    }
+    std::vector<uint32_t> visible =
+        cullBoth(culler, makeFrustum(), glm::vec3(20000000.0f, 0.5f, -20000000.0f), 96.0f);
+    CHECK(!visible.empty());
+}
+
+TEST_CASE("ChunkCuller: boxes straddling a plane are kept on both paths") {
+    ChunkCuller culler;
+    Frustum frustum = makeFrustum();
+
+    // Each box crosses one side plane (x = ±z or y = ±z at z = -10) or the near plane
+    culler.resize(6);
+    culler.setBounds(0, glm::ivec3(-15, -1, -11), glm::ivec3(-5, 1, -9));
+    culler.setBounds(1, glm::ivec3(5, -1, -11), glm::ivec3(15, 1, -9));
+    culler.setBounds(2, glm::ivec3(-1, -15, -11), glm::ivec3(1, -5, -9));
+    culler.setBounds(3, glm::ivec3(-1, 5, -11), glm::ivec3(1, 15, -9));
+    culler.setBounds(4, glm::ivec3(-1, -1, -1), glm::ivec3(1, 1, 1));
+    // ...and one just past the left plane
+    culler.setBounds(5, glm::ivec3(-30, -1, -11), glm::ivec3(-20, 1, -9));
+
+    std::vector<uint32_t> visible = cullBoth(culler, frustum, glm::vec3(0.0f), 100.0f);
+    CHECK(visible.size() == 5);
+    CHECK(std::find(visible.begin(), visible.end(), 5u) == visible.end());
+}
+
+TEST_CASE("ChunkCuller: boxes beyond the distance cutoff are dropped") {
+    ChunkCuller culler;
+    Frustum everything;  // All-zero planes keep every box
+
+    // A row of chunks along +X; the camera sits inside the first one
+    culler.resize(5);
+    for (int i = 0; i < 5; i++) {
+        culler.setBounds(i, glm::ivec3(i * 16, 0, 0), glm::ivec3(i * 16 + 16, 16, 16));
+    }
+    glm::vec3 camera(8.0f, 8.0f, 8.0f);
+
+    // Nearest points are 0, 8, 24, 40 and 56 blocks away
+    CHECK(cullBoth(culler, everything, camera, 40.0f).size() == 4);
+    CHECK(cullBoth(culler, everything, camera, 39.5f).size() == 3);
+    CHECK(cullBoth(culler, everything, camera, 100.0f).size() == 5);
+
+    // The chunk holding the camera survives any cutoff
+    std::vector<uint32_t> visible = cullBoth(culler, everything, camera, 0.0f);
+    CHECK(visible.size() == 1 && visible[0] == 0);
+}
+
+TEST_CASE("ChunkCuller: visible slots come out nearest first") {
+    ChunkCuller culler;
+    Frustum everything;
+
+    // Slot order scrambled relative to distance
+    const int chunkX[] = {3, -1, 5, 0, -4, 2, 1};
+    culler.resize(std::size(chunkX));
+    for (size_t slot = 0; slot < std::size(chunkX); slot++) {
+        culler.setBounds(slot, glm::ivec3(chunkX[slot] * 16, 0, 0), glm::ivec3(chunkX[slot] * 16 + 16, 16, 16));
+    }
+
+    // Camera just inside chunk 0, near its -X side
+    std::vector<uint32_t> visible = cullBoth(culler, everything, glm::vec3(2.0f, 8.0f, 8.0f), 1000.0f);
+    const std::vector<uint32_t> expected = {3, 1, 6, 5, 0, 4, 2};
+    CHECK(visible == expected);
+}
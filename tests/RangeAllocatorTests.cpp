@@ -0,0 +1,154 @@
+#include "TestHarness.hpp"
+#include "util/RangeAllocator.hpp"
+
+using namespace FarHorizon;
+
+TEST_CASE("RangeAllocator: allocations are packed from offset 0") {
+    RangeAllocator allocator(100);
+    CHECK(allocator.allocate(10) == 0);
+    CHECK(allocator.allocate(20) == 10);
+    CHECK(allocator.allocate(0) == 0);  // Size 0 allocates nothing
+    CHECK(allocator.getUsed() == 30);
+    CHECK(allocator.getFree() == 70);
+    CHECK(allocator.getFreeRangeCount() == 1);
+    CHECK(allocator.getLargestFreeRange() == 70);
+}
+
+TEST_CASE("RangeAllocator: free coalesces with both neighbors") {
+    RangeAllocator allocator(100);
+    uint32_t a = allocator.allocate(10);
+    uint32_t b = allocator.allocate(10);
+    uint32_t c = allocator.allocate(10);
+    allocator.allocate(10);  // Keeps the tail free range apart from c
+
+    allocator.free(a, 10);
+    allocator.free(c, 10);
+    CHECK(allocator.getFreeRangeCount() == 3);
+
+    // b joins the range before it and the range after it into [0, 30)
+    allocator.free(b, 10);
+    CHECK(allocator.getFreeRangeCount() == 2);
+    CHECK(allocator.getLargestFreeRange() == 60);
+    CHECK(allocator.allocate(30) == 0);
+}
+
+TEST_CASE("RangeAllocator: freeing everything leaves one range") {
+    RangeAllocator allocator(64);
+    uint32_t a = allocator.allocate(16);
+    uint32_t b = allocator.allocate(16);
+    uint32_t c = allocator.allocate(32);
+    allocator.free(b, 16);
+    allocator.free(c, 32);
+    allocator.free(a, 16);
+    CHECK(allocator.getUsed() == 0);
+    CHECK(allocator.getFreeRangeCount() == 1);
+    CHECK(allocator.getLargestFreeRange() == 64);
+}
+
+TEST_CASE("RangeAllocator: best fit picks the smallest range that holds the request") {
+    RangeAllocator allocator(100);
+    uint32_t a = allocator.allocate(30);  // [0, 30)
+    allocator.allocate(5);
+    uint32_t b = allocator.allocate(10);  // [35, 45)
+    allocator.allocate(5);
+    uint32_t c = allocator.allocate(10);  // [50, 60)
+    allocator.allocate(40);               // Fills the rest
+    CHECK(allocator.getFree() == 0);
+
+    allocator.free(a, 30);
+    allocator.free(b, 10);
+    allocator.free(c, 10);
+
+    // Free sizes are 30, 10 and 10: an 8 goes into the lowest 10, not the 30
+    CHECK(allocator.allocate(8) == 35);
+    CHECK(allocator.allocate(10) == 50);
+    CHECK(allocator.allocate(12) == 0);
+}
+
+TEST_CASE("RangeAllocator: full and out-of-space requests fail") {
+    RangeAllocator allocator(32);
+    CHECK(allocator.allocate(33) == RangeAllocator::INVALID_OFFSET);
+    CHECK(allocator.allocate(32) == 0);
+    CHECK(allocator.getFree() == 0);
+    CHECK(allocator.getLargestFreeRange() == 0);
+    CHECK(allocator.allocate(1) == RangeAllocator::INVALID_OFFSET);
+
+    // Enough free elements in total, but no single range holds them
+    allocator.free(0, 4);
+    allocator.free(8, 4);
+    CHECK(allocator.getFree() == 8);
+    CHECK(allocator.allocate(5) == RangeAllocator::INVALID_OFFSET);
+
+    RangeAllocator empty;
+    CHECK(empty.getCapacity() == 0);
+    CHECK(empty.allocate(1) == RangeAllocator::INVALID_OFFSET);
+}
+
+TEST_CASE("RangeAllocator: tryGrow extends into the free range right after") {
+    RangeAllocator allocator(100);
+    uint32_t a = allocator.allocate(10);
+    CHECK(allocator.tryGrow(a, 10, 25));
+    CHECK(allocator.getUsed() == 25);
+    CHECK(allocator.allocate(5) == 25);
+
+    // Blocked by the allocation at 25
+    CHECK(!allocator.tryGrow(a, 25, 26));
+    CHECK(allocator.getUsed() == 30);
+
+    // Shrinking is refused; the same size is a no-op success
+    CHECK(!allocator.tryGrow(a, 25, 20));
+    CHECK(allocator.tryGrow(a, 25, 25));
+
+    // Not enough room after the allocation at 25
+    CHECK(!allocator.tryGrow(25, 5, 76));
+    CHECK(allocator.tryGrow(25, 5, 75));
+    CHECK(allocator.getFree() == 0);
+}
+
+TEST_CASE("RangeAllocator: allocateBelow takes the lowest range under the limit") {
+    RangeAllocator allocator(100);
+    uint32_t a = allocator.allocate(10);  // [0, 10)
+    allocator.allocate(10);
+    uint32_t b = allocator.allocate(30);  // [20, 50)
+    allocator.allocate(10);
+    allocator.free(a, 10);
+    allocator.free(b, 30);
+
+    // Best fit would take [0, 10) too, but a 15 only fits at 20 or in the tail
+    CHECK(allocator.allocate(15) == 20);
+    allocator.free(20, 15);
+
+    // Lowest offset wins even where a tighter range exists higher up
+    CHECK(allocator.allocateBelow(5, 60) == 0);
+    CHECK(allocator.allocateBelow(10, 60) == 20);
+
+    // The range must end at or before the limit
+    CHECK(allocator.allocateBelow(25, 50) == RangeAllocator::INVALID_OFFSET);
+    CHECK(allocator.allocateBelow(20, 50) == 30);
+    CHECK(allocator.allocateBelow(10, 70) == 60);
+    CHECK(allocator.allocateBelow(0, 0) == 0);
+}
+
+TEST_CASE("RangeAllocator: getEnd is one past the highest allocation") {
+    RangeAllocator allocator(100);
+    CHECK(allocator.getEnd() == 0);
+
+    uint32_t a = allocator.allocate(10);
+    uint32_t b = allocator.allocate(20);
+    CHECK(allocator.getEnd() == 30);
+
+    // A hole below the end does not move it
+    allocator.free(a, 10);
+    CHECK(allocator.getEnd() == 30);
+
+    allocator.free(b, 20);
+    CHECK(allocator.getEnd() == 0);
+
+    allocator.allocate(100);
+    CHECK(allocator.getEnd() == 100);
+
+    allocator.reset(50);
+    CHECK(allocator.getCapacity() == 50);
+    CHECK(allocator.getUsed() == 0);
+    CHECK(allocator.getEnd() == 0);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+// Minimal self-registering test cases for the headless world library (no external framework,
+// so the tests build wherever FarHorizonWorld does). One executable runs every case;
+// a failed CHECK reports file:line and the case keeps running.
+
+namespace FarHorizon::Test {
+
+struct TestCase {
+    const char* name;
+    std::function<void()> body;
+};
+
+inline std::vector<TestCase>& getTestCases() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline int& getFailureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, std::function<void()> body) {
+        getTestCases().push_back({name, std::move(body)});
+    }
+};
+
+inline void reportFailure(const char* expression, const char* file, int line) {
+    std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+    getFailureCount()++;
+}
+
+} // namespace FarHorizon::Test
+
+#define FH_TEST_CONCAT_INNER(a, b) a##b
+#define FH_TEST_CONCAT(a, b) FH_TEST_CONCAT_INNER(a, b)
+
+#define TEST_CASE(name)                                                                             \
+    static void FH_TEST_CONCAT(testBody_, __LINE__)();                                             \
+    static ::FarHorizon::Test::TestRegistrar FH_TEST_CONCAT(testRegistrar_, __LINE__)(             \
+        name, &FH_TEST_CONCAT(testBody_, __LINE__));                                               \
+    static void FH_TEST_CONCAT(testBody_, __LINE__)()
+
+#define CHECK(expression)                                                                           \
+    do {                                                                                            \
+        if (!(expression)) {                                                                        \
+            ::FarHorizon::Test::reportFailure(#expression, __FILE__, __LINE__);                     \
+        }                                                                                           \
+    } while (false)
@@ -0,0 +1,22 @@
+#include "TestHarness.hpp"
+#include <cstring>
+
+// Usage: world_tests [name substring]
+int main(int argc, char** argv) {
+    using namespace FarHorizon::Test;
+
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int run = 0;
+    for (const TestCase& test : getTestCases()) {
+        if (filter && !std::strstr(test.name, filter)) {
+            continue;
+        }
+        int failuresBefore = getFailureCount();
+        test.body();
+        std::printf("[%s] %s\n", getFailureCount() == failuresBefore ? " OK " : "FAIL", test.name);
+        run++;
+    }
+
+    std::printf("%d test cases, %d failed checks\n", run, getFailureCount());
+    return getFailureCount() == 0 && run > 0 ? 0 : 1;
+}